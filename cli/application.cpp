@@ -68,6 +68,7 @@ Application::Application()
     , m_requiresMainEventLoop(true)
     , m_idleDuration(0)
     , m_idleTimeout(0)
+    , m_statsDuration(0)
     , m_argsRead(false)
 {
     // take ownership over the global QNetworkAccessManager
@@ -87,6 +88,7 @@ Application::Application()
     m_args.pwd.setCallback(bind(&Application::checkPwdOperationPresent, this, _1));
     m_args.cat.setCallback(bind(&Application::printConfig, this, _1));
     m_args.edit.setCallback(bind(&Application::editConfig, this, _1));
+    m_args.requestStats.setCallback(bind(&Application::printRequestStatistics, this, _1));
     m_args.statusPwd.setCallback(bind(&Application::printPwdStatus, this, _1));
     m_args.rescanPwd.setCallback(bind(&Application::requestRescanPwd, this, _1));
     m_args.pausePwd.setCallback(bind(&Application::requestPausePwd, this, _1));
@@ -135,7 +137,7 @@ int Application::exec(int argc, const char *const *argv)
 
     // finally do the request or establish connection
     if (m_args.status.isPresent() || m_args.rescan.isPresent() || m_args.rescanAll.isPresent() || m_args.pause.isPresent()
-        || m_args.resume.isPresent() || m_args.waitForIdle.isPresent() || m_args.pwd.isPresent()) {
+        || m_args.resume.isPresent() || m_args.waitForIdle.isPresent() || m_args.pwd.isPresent() || m_args.requestStats.isPresent()) {
         // those arguments require establishing a connection first, the actual handler is called by handleStatusChanged() when
         // the connection has been established
         m_connection.reconnect(m_settings);
@@ -225,6 +227,9 @@ int Application::loadConfig()
     if (const int res = assignIntegerFromArg(m_args.timeout, m_idleTimeout)) {
         return res;
     }
+    if (const int res = assignIntegerFromArg(m_args.duration, m_statsDuration)) {
+        return res;
+    }
 
     // disable polling for information which is not used by any CLI operation so far
     m_settings.trafficPollInterval = 0;
@@ -519,12 +524,15 @@ void Application::printDir(const RelevantDir &relevantDir) const
     printProperty("Last file name", dir->lastFileName);
     printProperty("Shared with", dir->deviceNames.isEmpty() ? dir->deviceIds : dir->deviceNames);
     printProperty("Download progress", dir->downloadLabel);
-    if (!dir->completionByDevice.empty()) {
-        printProperty("Remote progress", dir->areRemotesUpToDate() ? "all up-to-date" : "some need bytes");
-        for (const auto &completionForDev : dir->completionByDevice) {
-            printProperty(m_connection.deviceNameOrId(completionForDev.first).toLocal8Bit().data(),
-                argsToString(dataSizeToString(completionForDev.second.globalBytes - completionForDev.second.needed.bytes), ' ', '/', ' ',
-                    dataSizeToString(completionForDev.second.globalBytes), ' ', '(', static_cast<int>(completionForDev.second.percentage), " %)")
+    const auto &completion = m_connection.completionMatrix();
+    const auto dirHandle = m_connection.dirIds().handle(dir->id);
+    if (const auto &devHandles = completion.devsOf(dirHandle); !devHandles.empty()) {
+        printProperty("Remote progress", completion.areRemotesUpToDate(dirHandle) ? "all up-to-date" : "some need bytes");
+        for (const auto devHandle : devHandles) {
+            const auto &completionForDev = *completion.find(dirHandle, devHandle);
+            printProperty(m_connection.deviceNameOrId(m_connection.devIds().id(devHandle)).toLocal8Bit().data(),
+                argsToString(dataSizeToString(completionForDev.globalBytes - completionForDev.needed.bytes), ' ', '/', ' ',
+                    dataSizeToString(completionForDev.globalBytes), ' ', '(', static_cast<int>(completionForDev.percentage), " %)")
                     .data(),
                 nullptr, 6);
         }
@@ -979,8 +987,10 @@ void Application::waitForIdle(const ArgumentOccurrence &)
 
 bool Application::checkWhetherIdle() const
 {
+    const auto *const dirs = m_connection.dirInfo().data();
+    const auto &dirStatusTable = m_connection.dirStatusTable();
     for (const RelevantDir &dir : m_relevantDirs) {
-        switch (dir.dirObj->status) {
+        switch (dirStatusTable.status(static_cast<std::size_t>(dir.dirObj - dirs))) {
         case SyncthingDirStatus::Unknown:
         case SyncthingDirStatus::Idle:
             break;
@@ -1002,6 +1012,73 @@ bool Application::checkWhetherIdle() const
     return true;
 }
 
+void Application::printRequestStatistics(const ArgumentOccurrence &)
+{
+    // print statistics of the requests made so far when no duration has been specified
+    if (m_statsDuration <= 0) {
+        printEndpointStatistics();
+        QCoreApplication::exit();
+        return;
+    }
+
+    // keep the connection open to collect statistics of the regular polling
+    m_preventDisconnect = true;
+    cerr << Phrases::Info << "Collecting statistics for " << m_statsDuration << " ms ..." << TextAttribute::Reset << flush;
+    QTimer::singleShot(m_statsDuration, this, [this] {
+        cerr << Phrases::Override;
+        printEndpointStatistics();
+        m_connection.disconnect();
+        QCoreApplication::exit();
+    });
+}
+
+static std::string durationString(std::uint64_t microseconds)
+{
+    if (microseconds < 1000) {
+        return argsToString(microseconds, " us");
+    }
+    const auto hundredthMilliseconds = (microseconds + 5) / 10;
+    const auto fraction = hundredthMilliseconds % 100;
+    return argsToString(hundredthMilliseconds / 100, '.', fraction < 10 ? "0" : "", fraction, " ms");
+}
+
+static std::string distributionString(const SyncthingHistogram &histogram)
+{
+    return argsToString("mean ", durationString(histogram.mean()), ", p50 ", durationString(histogram.percentile(50.0)), ", p95 ",
+        durationString(histogram.percentile(95.0)), ", max ", durationString(histogram.max));
+}
+
+void Application::printEndpointStatistics() const
+{
+    const auto &endpointStats = m_connection.endpointStatistics();
+    if (endpointStats.empty()) {
+        cerr << Phrases::Warning << "No requests have been made" << Phrases::EndFlush;
+        return;
+    }
+    cout << TextAttribute::Bold << "Request statistics\n" << TextAttribute::Reset;
+    for (const auto &[path, stats] : endpointStats) {
+        if (!stats.requests && !stats.replies) {
+            continue;
+        }
+        cout << " - " << TextAttribute::Bold << path.toLocal8Bit().data() << '\n' << TextAttribute::Reset;
+        printProperty("Requests", argsToString(stats.requests, " sent, ", stats.replies, " handled, ", stats.errors, " failed"));
+        if (!stats.replies) {
+            cout << '\n';
+            continue;
+        }
+        printProperty("Latency", distributionString(stats.latency));
+        printProperty("Time to first byte", distributionString(stats.timeToFirstByte));
+        printProperty("Response size",
+            argsToString("mean ", dataSizeToString(stats.responseSize.mean()), ", max ", dataSizeToString(stats.responseSize.max)));
+        if (stats.parseTime.count) {
+            printProperty("Parse time", distributionString(stats.parseTime));
+        }
+        printProperty("Handler time", distributionString(stats.handlerTime));
+        cout << '\n';
+    }
+    cout.flush();
+}
+
 void Application::checkPwdOperationPresent(const ArgumentOccurrence &occurrence)
 {
     // FIXME: implement default operation in argument parser
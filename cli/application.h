@@ -77,6 +77,8 @@ private:
     void requestRescanPwd(const ArgumentOccurrence &occurrence);
     void requestPausePwd(const ArgumentOccurrence &occurrence);
     void requestResumePwd(const ArgumentOccurrence &occurrence);
+    void printRequestStatistics(const ArgumentOccurrence &);
+    void printEndpointStatistics() const;
     void initDirCompletion(Argument &arg, const ArgumentOccurrence &);
     void initDevCompletion(Argument &arg, const ArgumentOccurrence &);
     RelevantDir findDirectory(const QString &dirIdentifier);
@@ -95,6 +97,7 @@ private:
     QByteArray m_devCompletion;
     int m_idleDuration;
     int m_idleTimeout;
+    int m_statsDuration;
     bool m_argsRead;
 };
 
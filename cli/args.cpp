@@ -17,6 +17,7 @@ Args::Args()
     , pwd("pwd", 'p', "operates in the current working directory")
     , cat("cat", '\0', "prints the current Syncthing configuration")
     , edit("edit", '\0', "allows editing the Syncthing configuration using an external editor")
+    , requestStats("request-stats", '\0', "prints latency, payload size and parse time of the requests made to the Syncthing API")
     , statusPwd("status", 's', "prints the status of the current working directory")
     , rescanPwd("rescan", 'r', "rescans the current working directory")
     , pausePwd("pause", 'p', "pauses the current working directory")
@@ -32,6 +33,7 @@ Args::Args()
     , atLeast("at-least", 'a', "specifies for how many milliseconds Syncthing must idle (prevents exiting too early in case of flaky status)",
           { "number" })
     , timeout("timeout", 't', "specifies how many milliseconds to wait at most", { "number" })
+    , duration("duration", '\0', "specifies for how many milliseconds to keep the connection open to collect statistics", { "number" })
     , editor("editor", '\0', "specifies the editor to be opened", { "editor name", "editor option" })
     , configFile("config-file", 'f', "specifies the Syncthing config file to read API key and URL from, when not explicitly specified", { "path" })
     , apiKey("api-key", 'k', "specifies the API key", { "key" })
@@ -50,6 +52,8 @@ Args::Args()
     waitForIdle.setExample(PROJECT_NAME " wait-for-idle --timeout 1800000 --at-least 5000 && systemctl poweroff\n" PROJECT_NAME
                                         " wait-for-idle --dir dir1 --dir dir2 --dev dev1 --dev dev2 --at-least 5000");
     pwd.setSubArguments({ &statusPwd, &rescanPwd, &pausePwd, &resumePwd });
+    requestStats.setSubArguments({ &duration });
+    requestStats.setExample(PROJECT_NAME " request-stats --duration 60000");
 
     for (auto *arg : { &editor, &script, &jsLines }) {
         arg->setCombinable(false);
@@ -73,8 +77,8 @@ Args::Args()
     configFile.setExample(PROJECT_NAME " status --dir dir1 --config-file ~/.config/syncthing/config.xml");
     credentials.setExample(PROJECT_NAME " status --dir dir1 --credentials name supersecret");
 
-    parser.setMainArguments({ &status, &log, &stop, &restart, &rescan, &rescanAll, &pause, &resume, &waitForIdle, &pwd, &cat, &edit, &configFile,
-        &apiKey, &url, &credentials, &certificate, &parser.noColorArg(), &parser.helpArg() });
+    parser.setMainArguments({ &status, &log, &stop, &restart, &rescan, &rescanAll, &pause, &resume, &waitForIdle, &pwd, &cat, &edit, &requestStats,
+        &configFile, &apiKey, &url, &credentials, &certificate, &parser.noColorArg(), &parser.helpArg() });
 
     // allow setting default values via environment
     configFile.setEnvironmentVariable("SYNCTHING_CTL_CONFIG_FILE");
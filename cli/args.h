@@ -10,11 +10,11 @@ using namespace CppUtilities;
 struct Args {
     Args();
     ArgumentParser parser;
-    OperationArgument status, log, stop, restart, rescan, rescanAll, pause, resume, waitForIdle, pwd, cat, edit;
+    OperationArgument status, log, stop, restart, rescan, rescanAll, pause, resume, waitForIdle, pwd, cat, edit, requestStats;
     OperationArgument statusPwd, rescanPwd, pausePwd, resumePwd;
     ConfigValueArgument script, jsLines, dryRun;
     ConfigValueArgument stats, dir, dev, allDirs, allDevs;
-    ConfigValueArgument atLeast, timeout;
+    ConfigValueArgument atLeast, timeout, duration;
     ConfigValueArgument editor;
     ConfigValueArgument configFile, apiKey, url, credentials, certificate;
 };
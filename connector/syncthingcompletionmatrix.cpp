@@ -0,0 +1,104 @@
+#include "./syncthingcompletionmatrix.h"
+
+#include <algorithm>
+
+namespace Data {
+
+/// \cond
+template <typename Container> static auto &growTo(Container &container, std::size_t index)
+{
+    if (index >= container.size()) {
+        container.resize(index + 1);
+    }
+    return container[index];
+}
+
+static void eraseHandle(std::vector<SyncthingIdTable::Handle> &handles, SyncthingIdTable::Handle handle)
+{
+    if (const auto i = std::find(handles.begin(), handles.end(), handle); i != handles.end()) {
+        *i = handles.back();
+        handles.pop_back();
+    }
+}
+/// \endcond
+
+/*!
+ * \brief Returns the entry for \a dirHandle and \a devHandle, inserting an empty one if not present yet.
+ */
+SyncthingCompletion &SyncthingCompletionMatrix::insert(Handle dirHandle, Handle devHandle)
+{
+    const auto [i, inserted] = m_entries.try_emplace(key(dirHandle, devHandle));
+    if (inserted) {
+        growTo(m_devsByDir, dirHandle).emplace_back(devHandle);
+        growTo(m_dirsByDev, devHandle).emplace_back(dirHandle);
+        growTo(m_overallByDir, dirHandle);
+        growTo(m_overallByDev, devHandle);
+    }
+    return i->second;
+}
+
+/*!
+ * \brief Assigns the \a completion of the directory with \a dirHandle on the device with \a devHandle.
+ * \remarks Updates the overall completion of the device and the directory accordingly.
+ */
+void SyncthingCompletionMatrix::assign(Handle dirHandle, Handle devHandle, const SyncthingCompletion &completion)
+{
+    auto &entry = insert(dirHandle, devHandle);
+    auto &overallOfDir = m_overallByDir[dirHandle], &overallOfDev = m_overallByDev[devHandle];
+    overallOfDir -= entry;
+    overallOfDev -= entry;
+    overallOfDir += completion;
+    overallOfDev += completion;
+    overallOfDir.recomputePercentage();
+    overallOfDev.recomputePercentage();
+    entry = completion;
+}
+
+/*!
+ * \brief Sets whether the completion of the directory with \a dirHandle on the device with \a devHandle has been requested.
+ */
+void SyncthingCompletionMatrix::setRequested(Handle dirHandle, Handle devHandle, bool requested)
+{
+    if (requested) {
+        insert(dirHandle, devHandle).requested = true;
+    } else if (const auto i = m_entries.find(key(dirHandle, devHandle)); i != m_entries.end()) {
+        i->second.requested = false;
+    }
+}
+
+/*!
+ * \brief Removes all entries the specified \a predicate returns true for.
+ * \remarks Updates the overall completion of the affected devices and directories accordingly.
+ */
+void SyncthingCompletionMatrix::removeIf(const std::function<bool(Handle dirHandle, Handle devHandle)> &predicate)
+{
+    for (auto i = m_entries.begin(); i != m_entries.end();) {
+        const auto dirHandle = static_cast<Handle>(i->first >> 32), devHandle = static_cast<Handle>(i->first);
+        if (!predicate(dirHandle, devHandle)) {
+            ++i;
+            continue;
+        }
+        auto &overallOfDir = m_overallByDir[dirHandle], &overallOfDev = m_overallByDev[devHandle];
+        overallOfDir -= i->second;
+        overallOfDev -= i->second;
+        overallOfDir.recomputePercentage();
+        overallOfDev.recomputePercentage();
+        eraseHandle(m_devsByDir[dirHandle], devHandle);
+        eraseHandle(m_dirsByDev[devHandle], dirHandle);
+        i = m_entries.erase(i);
+    }
+}
+
+/*!
+ * \brief Removes all entries.
+ */
+void SyncthingCompletionMatrix::clear()
+{
+    m_entries.clear();
+    m_devsByDir.clear();
+    m_dirsByDev.clear();
+    m_overallByDir.clear();
+    m_overallByDev.clear();
+}
+
+} // namespace Data
@@ -0,0 +1,122 @@
+#ifndef DATA_SYNCTHINGCOMPLETIONMATRIX_H
+#define DATA_SYNCTHINGCOMPLETIONMATRIX_H
+
+#include "./syncthingcompletion.h"
+#include "./syncthingidtable.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingCompletionMatrix class stores the completion of directories on remote devices.
+ * \remarks
+ * - Entries are stored sparsely (most directories are only shared with a few devices) and indexed by the directory and
+ *   device handles of the SyncthingIdTable instances of the connection. Updating and querying a single entry is O(1).
+ * - The overall completion per device and per directory is maintained incrementally when entries are assigned or removed.
+ * - The devices a directory has completion information for and vice versa are tracked so views like "which devices still
+ *   need directory X" only need to iterate the relevant entries.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingCompletionMatrix {
+public:
+    using Handle = SyncthingIdTable::Handle;
+
+    const SyncthingCompletion *find(Handle dirHandle, Handle devHandle) const;
+    void assign(Handle dirHandle, Handle devHandle, const SyncthingCompletion &completion);
+    void setRequested(Handle dirHandle, Handle devHandle, bool requested);
+    void removeIf(const std::function<bool(Handle dirHandle, Handle devHandle)> &predicate);
+    void clear();
+
+    std::size_t size() const;
+    const std::vector<Handle> &devsOf(Handle dirHandle) const;
+    const std::vector<Handle> &dirsOf(Handle devHandle) const;
+    const SyncthingCompletion &overallCompletionOfDev(Handle devHandle) const;
+    const SyncthingCompletion &overallCompletionOfDir(Handle dirHandle) const;
+    bool areRemotesUpToDate(Handle dirHandle) const;
+
+private:
+    static constexpr std::uint64_t key(Handle dirHandle, Handle devHandle);
+    SyncthingCompletion &insert(Handle dirHandle, Handle devHandle);
+
+    std::unordered_map<std::uint64_t, SyncthingCompletion> m_entries;
+    std::vector<std::vector<Handle>> m_devsByDir;
+    std::vector<std::vector<Handle>> m_dirsByDev;
+    std::vector<SyncthingCompletion> m_overallByDir;
+    std::vector<SyncthingCompletion> m_overallByDev;
+};
+
+/*!
+ * \brief Returns the key for the entry of the specified \a dirHandle and \a devHandle.
+ */
+constexpr std::uint64_t SyncthingCompletionMatrix::key(Handle dirHandle, Handle devHandle)
+{
+    return (static_cast<std::uint64_t>(dirHandle) << 32) | devHandle;
+}
+
+/*!
+ * \brief Returns the completion of the directory with \a dirHandle on the device with \a devHandle or nullptr if unknown.
+ */
+inline const SyncthingCompletion *SyncthingCompletionMatrix::find(Handle dirHandle, Handle devHandle) const
+{
+    const auto i = m_entries.find(key(dirHandle, devHandle));
+    return i != m_entries.end() ? &i->second : nullptr;
+}
+
+/*!
+ * \brief Returns the number of entries.
+ */
+inline std::size_t SyncthingCompletionMatrix::size() const
+{
+    return m_entries.size();
+}
+
+/*!
+ * \brief Returns the devices the completion of the directory with \a dirHandle is known for.
+ */
+inline const std::vector<SyncthingCompletionMatrix::Handle> &SyncthingCompletionMatrix::devsOf(Handle dirHandle) const
+{
+    static const auto none = std::vector<Handle>();
+    return dirHandle < m_devsByDir.size() ? m_devsByDir[dirHandle] : none;
+}
+
+/*!
+ * \brief Returns the directories the completion on the device with \a devHandle is known for.
+ */
+inline const std::vector<SyncthingCompletionMatrix::Handle> &SyncthingCompletionMatrix::dirsOf(Handle devHandle) const
+{
+    static const auto none = std::vector<Handle>();
+    return devHandle < m_dirsByDev.size() ? m_dirsByDev[devHandle] : none;
+}
+
+/*!
+ * \brief Returns the overall completion of all directories on the device with \a devHandle.
+ */
+inline const SyncthingCompletion &SyncthingCompletionMatrix::overallCompletionOfDev(Handle devHandle) const
+{
+    static const auto none = SyncthingCompletion();
+    return devHandle < m_overallByDev.size() ? m_overallByDev[devHandle] : none;
+}
+
+/*!
+ * \brief Returns the overall completion of the directory with \a dirHandle on all devices.
+ */
+inline const SyncthingCompletion &SyncthingCompletionMatrix::overallCompletionOfDir(Handle dirHandle) const
+{
+    static const auto none = SyncthingCompletion();
+    return dirHandle < m_overallByDir.size() ? m_overallByDir[dirHandle] : none;
+}
+
+/*!
+ * \brief Returns whether the directory with \a dirHandle is up-to-date on all devices its completion is known for.
+ */
+inline bool SyncthingCompletionMatrix::areRemotesUpToDate(Handle dirHandle) const
+{
+    return overallCompletionOfDir(dirHandle).needed.isNull();
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGCOMPLETIONMATRIX_H
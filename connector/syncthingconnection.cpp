@@ -1,6 +1,7 @@
 #include "./syncthingconnection.h"
 #include "./syncthingconfig.h"
 #include "./syncthingconnectionsettings.h"
+#include "./syncthingevents.h"
 #include "./utils.h"
 
 #ifdef LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED
@@ -17,12 +18,14 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonValue>
+#include <QMetaMethod>
 #include <QNetworkAccessManager>
 #include <QNetworkInterface>
 #include <QNetworkReply>
 #include <QStringBuilder>
 #include <QTimer>
 
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -94,14 +97,29 @@ SyncthingConnection::SyncthingConnection(
     , m_versionReply(nullptr)
     , m_diskEventsReply(nullptr)
     , m_logReply(nullptr)
+    , m_trafficPollInterval(SyncthingConnectionSettings::defaultTrafficPollInterval)
+    , m_devStatsPollInterval(SyncthingConnectionSettings::defaultDevStatusPollInterval)
+    , m_errorsPollInterval(SyncthingConnectionSettings::defaultErrorsPollInterval)
+    , m_maxPollBackoffFactor(SyncthingConnectionSettings::defaultMaxPollBackoffFactor)
+    , m_pollBackoffFactor(1)
+    , m_visibleUserInterfaces(0)
+    , m_maxConcurrentRequests(SyncthingConnectionSettings::defaultMaxConcurrentRequests)
     , m_unreadNotifications(false)
     , m_hasConfig(false)
     , m_hasStatus(false)
     , m_hasEvents(false)
     , m_hasDiskEvents(false)
+    , m_resumeState(ResumeState::None)
+    , m_configHash(0)
     , m_lastFileDeleted(false)
     , m_dirStatsAltered(false)
     , m_recordFileChanges(false)
+    , m_recentChangesCapacity(SyncthingConnectionSettings::defaultRecentChangesCapacity)
+    , m_recentChangesMemoryBudget(SyncthingConnectionSettings::defaultRecentChangesMemoryBudget)
+    , m_recentChangesMemoryUsage(0)
+    , m_batchingStatusChanges(false)
+    , m_resettingDirsAndDevs(true)
+    , m_hasStaleDirsAndDevs(false)
 {
     m_trafficPollTimer.setInterval(SyncthingConnectionSettings::defaultTrafficPollInterval);
     m_trafficPollTimer.setTimerType(Qt::VeryCoarseTimer);
@@ -115,15 +133,20 @@ SyncthingConnection::SyncthingConnection(
     m_errorsPollTimer.setTimerType(Qt::VeryCoarseTimer);
     m_errorsPollTimer.setSingleShot(true);
     QObject::connect(&m_errorsPollTimer, &QTimer::timeout, this, &SyncthingConnection::requestErrors);
+    m_pollActivityTimer.start();
     m_autoReconnectTimer.setTimerType(Qt::VeryCoarseTimer);
     m_autoReconnectTimer.setInterval(SyncthingConnectionSettings::defaultReconnectInterval);
     QObject::connect(&m_autoReconnectTimer, &QTimer::timeout, this, &SyncthingConnection::autoReconnect);
+    m_snapshotTimer.setTimerType(Qt::VeryCoarseTimer);
+    QObject::connect(&m_snapshotTimer, &QTimer::timeout, this, &SyncthingConnection::saveSnapshotIfUpToDate);
+    m_requestClock.start();
 
 #ifdef LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED
     setupTestData();
 #endif
 
     setLoggingFlags(loggingFlags);
+    updateEventFilter();
 }
 
 /*!
@@ -131,6 +154,7 @@ SyncthingConnection::SyncthingConnection(
  */
 SyncthingConnection::~SyncthingConnection()
 {
+    saveSnapshotIfUpToDate();
     m_status = SyncthingStatus::BeingDestroyed;
     disconnect();
 }
@@ -212,16 +236,258 @@ void SyncthingConnection::setLoggingFlags(SyncthingConnectionLoggingFlags flags)
 }
 
 /*!
- * \brief Returns whether there is at least one directory out-of-sync.
+ * \brief Sets whether completion for all directories of all devices should be requested automatically.
+ * \remarks
+ * - Completion can be requested manually using requestCompletion().
+ * - "RemoteIndexUpdated" events are only requested and handled if enabled. So when disabled, completion is not refreshed
+ *   automatically when a remote device updates its index either.
  */
-bool SyncthingConnection::hasOutOfSyncDirs() const
+void SyncthingConnection::setRequestingCompletionEnabled(bool requestingCompletionEnabled)
 {
-    for (const SyncthingDir &dir : m_dirs) {
-        if (dir.status == SyncthingDirStatus::OutOfSync) {
-            return true;
+    if (m_requestCompletion != requestingCompletionEnabled) {
+        m_requestCompletion = requestingCompletionEnabled;
+        updateEventFilter();
+    }
+}
+
+/*!
+ * \brief Sets whether file changes are recorded for each directory so SyncthingDir::recentChanges is being populated.
+ * \remarks The fileChanged() signal is unaffected.
+ */
+void SyncthingConnection::setRecordFileChanges(bool recordFileChanges)
+{
+    m_recordFileChanges = recordFileChanges;
+    requestDiskEventsIfRequired();
+}
+
+/*!
+ * \brief Sets the max. number of file changes recorded per directory if recordFileChanges() is enabled.
+ * \remarks
+ * - If more changes are already recorded for a directory, the oldest ones are discarded.
+ * - Invalidates references to all recorded changes.
+ */
+void SyncthingConnection::setRecentChangesCapacity(std::size_t recentChangesCapacity)
+{
+    if (m_recentChangesCapacity == recentChangesCapacity) {
+        return;
+    }
+    m_recentChangesCapacity = recentChangesCapacity;
+    for (auto &dir : m_dirs) {
+        dir.recentChanges.setCapacity(recentChangesCapacity);
+    }
+    updateRecentChangesMemoryUsage();
+}
+
+/*!
+ * \brief Sets the max. number of bytes (approximately) file changes recorded across all directories may use.
+ * \remarks If more memory is already used, the oldest changes are discarded.
+ */
+void SyncthingConnection::setRecentChangesMemoryBudget(std::size_t recentChangesMemoryBudget)
+{
+    m_recentChangesMemoryBudget = recentChangesMemoryBudget;
+    enforceRecentChangesMemoryBudget();
+}
+
+/*!
+ * \brief Sets the factor the poll intervals are multiplied with at most while Syncthing is idling.
+ * \remarks
+ * - While no directory is scanning or synchronizing, no remote device is synchronizing and no UI is visible (see
+ *   addVisibleUserInterface()) the poll intervals double every minute until this factor is reached.
+ * - Events indicating activity reset the factor to one immediately, shortening timers which are already running.
+ * - A value of one (or less) disables the backoff.
+ * - The current factor and effective intervals can be queried via pollBackoffFactor() and effectiveTrafficPollInterval(),
+ *   effectiveDevStatsPollInterval() and effectiveErrorsPollInterval().
+ */
+void SyncthingConnection::setMaxPollBackoffFactor(int maxPollBackoffFactor)
+{
+    m_maxPollBackoffFactor = maxPollBackoffFactor;
+    if (m_pollBackoffFactor > std::max(maxPollBackoffFactor, 1)) {
+        handlePollingActivity();
+    }
+}
+
+/*!
+ * \brief Registers that a UI showing information about the connection (e.g. the tray menu or the Plasmoid popup) became visible.
+ * \remarks
+ * - The connection might be shared by multiple UIs (see SyncthingConnectionRegistry) so visibility is reference-counted. Each
+ *   UI is supposed to call removeVisibleUserInterface() exactly once when it is hidden again or stops using the connection.
+ * - Polling happens at the configured intervals while a UI is visible. See setMaxPollBackoffFactor() for details.
+ */
+void SyncthingConnection::addVisibleUserInterface()
+{
+    ++m_visibleUserInterfaces;
+    handlePollingActivity();
+}
+
+/*!
+ * \brief Registers that a UI previously registered via addVisibleUserInterface() has been hidden or stopped using the connection.
+ */
+void SyncthingConnection::removeVisibleUserInterface()
+{
+    if (m_visibleUserInterfaces > 0) {
+        --m_visibleUserInterfaces;
+    }
+}
+
+/*!
+ * \brief Starts the specified \a pollTimer with the specified \a pollInterval multiplied by the backoff factor.
+ * \remarks The backoff factor is re-computed first; it doubles every minute without activity. See setMaxPollBackoffFactor().
+ */
+void SyncthingConnection::startPollTimer(QTimer &pollTimer, int pollInterval)
+{
+    static constexpr auto pollBackoffStep = 60000;
+    if (!pollInterval) {
+        return;
+    }
+    switch (m_status) {
+    case SyncthingStatus::Scanning:
+    case SyncthingStatus::Synchronizing:
+    case SyncthingStatus::RemoteNotInSync:
+        m_pollActivityTimer.restart();
+        break;
+    default:
+        if (m_visibleUserInterfaces) {
+            m_pollActivityTimer.restart();
+        }
+    }
+    if (m_maxPollBackoffFactor <= 1) {
+        m_pollBackoffFactor = 1;
+    } else {
+        const auto steps = m_pollActivityTimer.elapsed() / pollBackoffStep;
+        m_pollBackoffFactor = steps >= 30 ? m_maxPollBackoffFactor : std::min(m_maxPollBackoffFactor, 1 << steps);
+    }
+    pollTimer.start(scaledPollInterval(pollInterval));
+}
+
+/*!
+ * \brief Resets the backoff factor and shortens running poll timers accordingly.
+ * \remarks Invoked when the UI becomes visible or an event indicates activity. See setMaxPollBackoffFactor().
+ */
+void SyncthingConnection::handlePollingActivity()
+{
+    m_pollActivityTimer.restart();
+    if (m_pollBackoffFactor == 1) {
+        return;
+    }
+    m_pollBackoffFactor = 1;
+    for (auto [pollTimer, pollInterval] : { std::pair(&m_trafficPollTimer, m_trafficPollInterval),
+             std::pair(&m_devStatsPollTimer, m_devStatsPollInterval), std::pair(&m_errorsPollTimer, m_errorsPollInterval) }) {
+        if (pollTimer->isActive() && pollTimer->remainingTime() > pollInterval) {
+            pollTimer->start(pollInterval);
+        }
+    }
+}
+
+/*!
+ * \brief Updates the event filter if a signal affecting it has been connected.
+ */
+void SyncthingConnection::connectNotify(const QMetaMethod &signal)
+{
+    QObject::connectNotify(signal);
+    if (signal == QMetaMethod::fromSignal(&SyncthingConnection::newEvents)) {
+        updateEventFilter();
+    } else if (signal == QMetaMethod::fromSignal(&SyncthingConnection::fileChanged)) {
+        requestDiskEventsIfRequired();
+    }
+}
+
+/*!
+ * \brief Updates the event filter if a signal affecting it has been disconnected.
+ * \remarks The \a signal is invalid when all signals have been disconnected at once.
+ */
+void SyncthingConnection::disconnectNotify(const QMetaMethod &signal)
+{
+    QObject::disconnectNotify(signal);
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&SyncthingConnection::newEvents)) {
+        updateEventFilter();
+    }
+}
+
+/*!
+ * \brief Computes the "events" parameter for requestEvents() so only events are requested which are actually handled.
+ * \remarks
+ * - Change events are not requested via requestEvents() because they are polled via requestDiskEvents().
+ * - "ItemStarted" is not requested because it is not handled yet.
+ * - "RemoteIndexUpdated" is only requested if requesting completion is enabled because it only triggers requesting completion
+ *   and readRemoteIndexUpdated() ignores it otherwise.
+ * - No filter is used at all if newEvents() is connected because the connected slots might be interested in any event.
+ * - Syncthing numbers events separately for each filter so the event subscription is restarted via restartEvents() if the
+ *   filter changes while events are polled.
+ */
+void SyncthingConnection::updateEventFilter()
+{
+    auto eventFilter = QString();
+    if (!isSignalConnected(QMetaMethod::fromSignal(&SyncthingConnection::newEvents))) {
+        auto eventTypes = allSyncthingEventTypes;
+        eventTypes &= ~(syncthingEventTypeFlag(SyncthingEventType::LocalChangeDetected)
+            | syncthingEventTypeFlag(SyncthingEventType::RemoteChangeDetected) | syncthingEventTypeFlag(SyncthingEventType::ItemStarted));
+        if (!m_requestCompletion) {
+            eventTypes &= ~syncthingEventTypeFlag(SyncthingEventType::RemoteIndexUpdated);
         }
+        eventFilter = syncthingEventFilter(eventTypes);
+    }
+    if (eventFilter == m_eventFilter) {
+        return;
+    }
+    m_eventFilter = std::move(eventFilter);
+    if (m_eventsReply || m_lastEventId) {
+        restartEvents();
     }
-    return false;
+}
+
+/*!
+ * \brief Restarts polling events from scratch; called by updateEventFilter() when the filter has changed.
+ * \remarks
+ * - The last event ID refers to the sequence of the previous filter so it is discarded and the events are re-primed by
+ *   requesting only the latest event. An ongoing long-polling request is aborted without being treated as cancellation.
+ * - The directory status is re-synced via resyncDirs() because events might have been missed in the meantime.
+ */
+void SyncthingConnection::restartEvents()
+{
+    auto *const pendingReply = std::exchange(m_eventsReply, nullptr);
+    if (pendingReply) {
+        QObject::disconnect(pendingReply, &QNetworkReply::finished, this, &SyncthingConnection::readEvents);
+        pendingReply->abort();
+        pendingReply->deleteLater();
+    }
+    m_lastEventId = 0;
+    m_hasEvents = false;
+    if (m_resumeState == ResumeState::CheckingEvents) {
+        m_resumeState = ResumeState::None;
+    }
+    if (!pendingReply) {
+        return;
+    }
+    requestEvents();
+    if (isConnected()) {
+        resyncDirs();
+    }
+}
+
+/*!
+ * \brief Returns whether polling disk events is required because file changes are recorded or fileChanged() is connected.
+ */
+bool SyncthingConnection::isDiskEventsPollingRequired() const
+{
+    return m_recordFileChanges || isSignalConnected(QMetaMethod::fromSignal(&SyncthingConnection::fileChanged));
+}
+
+/*!
+ * \brief Starts polling disk events if connected, required and not already done.
+ */
+void SyncthingConnection::requestDiskEventsIfRequired()
+{
+    if (m_keepPolling && m_hasConfig && m_hasStatus && !m_diskEventsReply && isDiskEventsPollingRequired()) {
+        requestDiskEvents();
+    }
+}
+
+/*!
+ * \brief Returns whether there is at least one directory out-of-sync.
+ */
+bool SyncthingConnection::hasOutOfSyncDirs() const
+{
+    return m_dirStatusTable.hasStatus(SyncthingDirStatus::OutOfSync);
 }
 
 /*!
@@ -242,8 +508,13 @@ void SyncthingConnection::disablePolling()
  * the connection to the currently configured instance is established. Use reconnect() to connect to
  * a different instance.
  *
- * \remarks Does not clear data from a previous connection (except error items). Use reconnect() if that
- *          is required.
+ * \remarks
+ * - Does not clear data from a previous connection (except error items). Use reconnect() if that is required.
+ * - If the connection to the same Syncthing instance has been lost (e.g. due to a network blip or suspend/resume), the
+ *   previous session is resumed: Only the status is requested to check whether Syncthing has been restarted meanwhile.
+ *   If not, the existing directories and devices are kept and polling events continues from the last event ID.
+ *   Directories and devices are only re-synced if events have been missed and only re-assigned from scratch if the
+ *   configuration has changed as well. See continueResuming() for details.
  */
 void SyncthingConnection::connect()
 {
@@ -256,8 +527,11 @@ void SyncthingConnection::connect()
         return;
     }
 
-    // reset status
-    m_abortingToReconnect = m_hasConfig = m_hasStatus = m_hasEvents = m_hasDiskEvents = false;
+    // reset status; keep the config of the previous session if it can be resumed
+    const auto resuming = canResume();
+    m_abortingToReconnect = m_hasStatus = m_hasEvents = m_hasDiskEvents = false;
+    m_hasConfig = resuming;
+    m_resumeState = resuming ? ResumeState::CheckingStatus : ResumeState::None;
 
     // check configuration
     if (m_apiKey.isEmpty() || m_syncthingUrl.isEmpty()) {
@@ -267,7 +541,10 @@ void SyncthingConnection::connect()
     }
 
     // start by requesting config and status; if both are available request further info and events
-    requestConfig();
+    // note: When resuming, only the status is requested to check whether the config can be kept.
+    if (!resuming) {
+        requestConfig();
+    }
     requestStatus();
     m_keepPolling = true;
 }
@@ -319,6 +596,7 @@ void SyncthingConnection::disconnect()
 void SyncthingConnection::abortAllRequests()
 {
     m_abortingAllRequests = true;
+    clearRequestQueue();
     if (m_configReply) {
         m_configReply->abort();
     }
@@ -361,6 +639,7 @@ void SyncthingConnection::abortAllRequests()
  * \brief Disconnects if connected, then (re-)connects asynchronously.
  * \remarks
  * - Clears the currently cached configuration.
+ * - Keeps directories and devices of the previous connection as stale ones; see hasStaleDirsAndDevs().
  * - This explicit request to reconnect will reset the autoReconnectTries().
  */
 void SyncthingConnection::reconnect()
@@ -415,12 +694,14 @@ void SyncthingConnection::continueReconnecting()
     // notify that we're about to invalidate the configuration if not already invalidated anyways
     const auto isConfigInvalidated = m_rawConfig.isEmpty();
     if (!isConfigInvalidated) {
+        m_resettingDirsAndDevs = true;
         emit newConfig(m_rawConfig = QJsonObject());
     }
 
     // cleanup information from previous connection
     m_keepPolling = true;
     m_abortingToReconnect = false;
+    m_resumeState = ResumeState::None;
     m_lastEventId = 0;
     m_lastDiskEventId = 0;
     m_configDir.clear();
@@ -435,8 +716,33 @@ void SyncthingConnection::continueReconnecting()
     m_hasStatus = false;
     m_hasEvents = false;
     m_hasDiskEvents = false;
-    m_dirs.clear();
-    m_devs.clear();
+    if (!isConfigInvalidated && (!m_dirs.empty() || !m_devs.empty())) {
+        // keep dirs/devs from the previous connection as stale dirs/devs until the connection has been re-established
+        for (auto &dir : m_dirs) {
+            dir.status = SyncthingDirStatus::Unknown;
+        }
+        for (auto &dev : m_devs) {
+            if (dev.status != SyncthingDevStatus::OwnDevice) {
+                dev.status = SyncthingDevStatus::Unknown;
+            }
+        }
+        m_dirStatusTable.assign(m_dirs);
+        m_devStatusTable.assign(m_devs);
+        m_hasStaleDirsAndDevs = true;
+        emit newDevices(m_devs);
+        emit newDirs(m_dirs);
+    } else if (!m_hasStaleDirsAndDevs) {
+        // keep dirs/devs restored from a snapshot; otherwise discard them
+        m_dirs.clear();
+        m_devs.clear();
+        m_recentChangesMemoryUsage = 0;
+        m_dirIds.clearRows();
+        m_devIds.clearRows();
+        m_dirStatusTable.clear();
+        m_dirPathIndex.clear();
+        m_devStatusTable.clear();
+        m_completion.clear();
+    }
     m_lastConnectionsUpdate = DateTime();
     m_lastFileTime = DateTime();
     m_lastErrorTime = DateTime();
@@ -475,6 +781,25 @@ void SyncthingConnection::concludeReadingConfigAndStatus()
         return;
     }
 
+    // reconcile dirs/devs restored from a snapshot in place; requesting their status is done in continueConnecting()
+    if (!m_resettingDirsAndDevs && m_hasStaleDirsAndDevs) {
+        m_hasStaleDirsAndDevs = false;
+        updateDevs(m_rawConfig.value(QLatin1String("devices")).toArray());
+        updateDirs(m_rawConfig.value(QLatin1String("folders")).toArray());
+        emit newDevices(m_devs);
+        emit newDirs(m_dirs);
+        emit newConfigApplied();
+        continueConnecting();
+        return;
+    }
+
+    // update dirs/devs in place if the connection has already been established (config has only been altered)
+    if (!m_resettingDirsAndDevs) {
+        updateDirsAndDevs();
+        emit newConfigApplied();
+        return;
+    }
+
     readDevs(m_rawConfig.value(QLatin1String("devices")).toArray());
     readDirs(m_rawConfig.value(QLatin1String("folders")).toArray());
     emit newConfigApplied();
@@ -514,13 +839,25 @@ void SyncthingConnection::autoReconnect()
  */
 SyncthingDir *SyncthingConnection::findDirInfo(const QString &dirId, int &row)
 {
-    row = 0;
-    for (SyncthingDir &d : m_dirs) {
-        if (d.id == dirId) {
-            return &d;
+    return findDirInfo(m_dirIds.handle(dirId), row);
+}
+
+/*!
+ * \brief Returns the directory info object for the directory with the specified \a dirHandle.
+ * \remarks Unlike the lookup by ID this does not involve any string hashing.
+ */
+SyncthingDir *SyncthingConnection::findDirInfo(SyncthingIdTable::Handle dirHandle, int &row)
+{
+    // note: Checking the ID of the indexed directory as well because the directory might have been moved out of m_dirs
+    //       within readDirs() already.
+    if (const auto indexedRow = m_dirIds.row(dirHandle); indexedRow != SyncthingIdTable::noRow) {
+        auto &dir = m_dirs[static_cast<std::size_t>(indexedRow)];
+        if (dir.id == m_dirIds.id(dirHandle)) {
+            row = indexedRow;
+            return &dir;
         }
-        ++row;
     }
+    row = static_cast<int>(m_dirs.size());
     return nullptr;
 }
 
@@ -545,22 +882,19 @@ SyncthingDir *SyncthingConnection::findDirInfo(QLatin1String key, const QJsonObj
  * to the location of the corresponding Syncthing directory.
  *
  * \returns Returns a pointer to the object or nullptr if not found.
- * \remarks The returned object becomes invalid when the newDirs() signal is emitted or the connection is destroyed.
+ * \remarks
+ * - If directories are nested, the deepest directory containing \a path is returned.
+ * - The lookup is done via dirPathIndex() so its costs depend on the depth of \a path and not on the number of directories.
+ * - The returned object becomes invalid when the newDirs() signal is emitted or the connection is destroyed.
  */
 SyncthingDir *SyncthingConnection::findDirInfoByPath(const QString &path, QString &relativePath, int &row)
 {
-    row = 0;
-    for (SyncthingDir &dir : m_dirs) {
-        if (path == dir.pathWithoutTrailingSlash()) {
-            relativePath.clear();
-            return &dir;
-        } else if (path.startsWith(dir.path)) {
-            relativePath = path.mid(dir.path.size());
-            return &dir;
-        }
-        ++row;
+    auto match = m_dirPathIndex.find(path);
+    if ((row = match.row) < 0 || static_cast<std::size_t>(row) >= m_dirs.size()) {
+        return nullptr;
     }
-    return nullptr;
+    relativePath = std::move(match.relativePath);
+    return &m_dirs[static_cast<std::size_t>(row)];
 }
 
 /*!
@@ -592,13 +926,25 @@ SyncthingDir *SyncthingConnection::addDirInfo(std::vector<SyncthingDir> &dirs, c
  */
 SyncthingDev *SyncthingConnection::findDevInfo(const QString &devId, int &row)
 {
-    row = 0;
-    for (SyncthingDev &d : m_devs) {
-        if (d.id == devId) {
-            return &d;
+    return findDevInfo(m_devIds.handle(devId), row);
+}
+
+/*!
+ * \brief Returns the device info object for the device with the specified \a devHandle.
+ * \remarks Unlike the lookup by ID this does not involve any string hashing.
+ */
+SyncthingDev *SyncthingConnection::findDevInfo(SyncthingIdTable::Handle devHandle, int &row)
+{
+    // note: Checking the ID of the indexed device as well because the device might have been moved out of m_devs
+    //       within readDevs() already.
+    if (const auto indexedRow = m_devIds.row(devHandle); indexedRow != SyncthingIdTable::noRow) {
+        auto &dev = m_devs[static_cast<std::size_t>(indexedRow)];
+        if (dev.id == m_devIds.id(devHandle)) {
+            row = indexedRow;
+            return &dev;
         }
-        ++row;
     }
+    row = static_cast<int>(m_devs.size());
     return nullptr;
 }
 
@@ -642,10 +988,9 @@ QStringList SyncthingConnection::deviceIds() const
  */
 QString SyncthingConnection::deviceNameOrId(const QString &deviceId) const
 {
-    for (const auto &dev : devInfo()) {
-        if (dev.id == deviceId) {
-            return dev.name;
-        }
+    int row;
+    if (const auto *const dev = findDevInfo(deviceId, row)) {
+        return dev->name;
     }
     return deviceId;
 }
@@ -688,6 +1033,49 @@ SyncthingDev *SyncthingConnection::addDevInfo(std::vector<SyncthingDev> &devs, c
     return &devs.back();
 }
 
+/*!
+ * \brief Rebuilds the indices used by findDirInfo() and findDirInfoByPath() and the status table.
+ * \remarks
+ * - Must be called whenever m_dirs is re-assigned. If the same ID is present multiple times, the first occurrence is indexed.
+ * - Interns the IDs of all directories so they share their data with the ID table.
+ */
+void SyncthingConnection::indexDirs()
+{
+    m_dirStatusTable.assign(m_dirs);
+    m_dirPathIndex.assign(m_dirs);
+    m_dirIds.clearRows();
+    auto row = 0;
+    for (auto &dir : m_dirs) {
+        const auto handle = m_dirIds.intern(dir.id);
+        dir.id = m_dirIds.id(handle);
+        if (m_dirIds.row(handle) == SyncthingIdTable::noRow) {
+            m_dirIds.setRow(handle, row);
+        }
+        ++row;
+    }
+}
+
+/*!
+ * \brief Rebuilds the index used by findDevInfo() to look up devices by ID in constant time and the status table.
+ * \remarks
+ * - Must be called whenever m_devs is re-assigned. If the same ID is present multiple times, the first occurrence is indexed.
+ * - Interns the IDs of all devices so they share their data with the ID table.
+ */
+void SyncthingConnection::indexDevs()
+{
+    m_devStatusTable.assign(m_devs);
+    m_devIds.clearRows();
+    auto row = 0;
+    for (auto &dev : m_devs) {
+        const auto handle = m_devIds.intern(dev.id);
+        dev.id = m_devIds.id(handle);
+        if (m_devIds.row(handle) == SyncthingIdTable::noRow) {
+            m_devIds.setRow(handle, row);
+        }
+        ++row;
+    }
+}
+
 /*!
  * \brief Internally called to parse a time stamp.
  */
@@ -716,12 +1104,35 @@ void SyncthingConnection::continueConnecting()
     }
 
     // read additional information (beside config and status)
+    resyncDirsAndDevs();
+    requestVersion();
+
+    // poll for events
+    m_lastEventId = m_lastDiskEventId = 0;
+    requestEvents();
+    requestDiskEventsIfRequired();
+}
+
+/*!
+ * \brief Requests all information about directories and devices beside their config (e.g. status, statistics and completion).
+ * \remarks Called by continueConnecting() and when resuming a session in case events have been missed.
+ */
+void SyncthingConnection::resyncDirsAndDevs()
+{
     // FIXME: make those requests configurable (eg. flag enum)
     requestConnections();
-    requestDirStatistics();
     requestDeviceStatistics();
     requestErrors();
-    requestVersion();
+    resyncDirs();
+}
+
+/*!
+ * \brief Requests the information about directories which is otherwise only kept up-to-date via events (statistics, status and completion).
+ * \remarks Called by resyncDirsAndDevs() and by restartEvents() because events might have been missed when re-subscribing.
+ */
+void SyncthingConnection::resyncDirs()
+{
+    requestDirStatistics();
     for (const SyncthingDir &dir : m_dirs) {
         requestDirStatus(dir.id);
         if (!m_requestCompletion || dir.paused) {
@@ -731,11 +1142,42 @@ void SyncthingConnection::continueConnecting()
             requestCompletion(devId, dir.id);
         }
     }
+}
 
-    // poll for events
-    m_lastEventId = m_lastDiskEventId = 0;
-    requestEvents();
-    requestDiskEvents();
+/*!
+ * \brief Returns whether the previous session can be resumed when connecting via connect().
+ * \remarks This is the case if config, status and events have been received from Syncthing before and the
+ *          directories and devices have not been restored from a snapshot.
+ */
+bool SyncthingConnection::canResume() const
+{
+    return m_hasConfig && m_lastEventId && !m_myId.isEmpty() && !m_startTime.isNull() && !m_hasStaleDirsAndDevs;
+}
+
+/*!
+ * \brief Continues resuming the previous session after the status has been read; called by readStatus().
+ * \remarks
+ * - If the Syncthing instance has not been restarted (\a sameInstance), all existing state is kept and polling events continues
+ *   from the last event ID. Only information which is otherwise polled periodically is requested. Whether events have been missed
+ *   is checked when reading the first events; in this case resyncDirsAndDevs() is invoked.
+ * - If the same device has been restarted (\a sameDevice), the config is requested. If it has not changed, directories and devices
+ *   are kept and only re-synced via continueConnecting(). Otherwise they are re-assigned from scratch as when connecting normally.
+ * - If the device ID has changed, the config is requested and directories and devices are re-assigned from scratch.
+ */
+void SyncthingConnection::continueResuming(bool sameDevice, bool sameInstance)
+{
+    if (sameInstance) {
+        m_resumeState = ResumeState::CheckingEvents;
+        requestConnections();
+        requestDeviceStatistics();
+        requestErrors();
+        requestEvents();
+        requestDiskEventsIfRequired();
+        return;
+    }
+    m_resumeState = sameDevice ? ResumeState::CheckingConfig : ResumeState::None;
+    m_hasConfig = false;
+    requestConfig();
 }
 
 /*!
@@ -826,7 +1268,11 @@ bool SyncthingConnection::applySettings(SyncthingConnectionSettings &connectionS
     setTrafficPollInterval(connectionSettings.trafficPollInterval);
     setDevStatsPollInterval(connectionSettings.devStatsPollInterval);
     setErrorsPollInterval(connectionSettings.errorsPollInterval);
+    setMaxPollBackoffFactor(connectionSettings.maxPollBackoffFactor);
     setAutoReconnectInterval(connectionSettings.reconnectInterval);
+    setMaxConcurrentRequests(connectionSettings.maxConcurrentRequests);
+    setRecentChangesCapacity(connectionSettings.recentChangesCapacity);
+    setRecentChangesMemoryBudget(connectionSettings.recentChangesMemoryBudget);
     setStatusComputionFlags(connectionSettings.statusComputionFlags);
 
     return reconnectRequired;
@@ -879,37 +1325,23 @@ void SyncthingConnection::setStatus(SyncthingStatus status)
         // check whether at least one directory is scanning, preparing to synchronize or synchronizing
         // note: We don't distinguish between "preparing to sync" and "synchronizing" for computing the overall
         //       status at the moment.
-        auto scanning = false, synchronizing = false, remoteSynchronizing = false;
-        if (m_statusComputionFlags & SyncthingStatusComputionFlags::Synchronizing
-            || m_statusComputionFlags & SyncthingStatusComputionFlags::Scanning) {
-            for (const SyncthingDir &dir : m_dirs) {
-                switch (dir.status) {
-                case SyncthingDirStatus::WaitingToSync:
-                case SyncthingDirStatus::PreparingToSync:
-                case SyncthingDirStatus::Synchronizing:
-                    synchronizing = m_statusComputionFlags & SyncthingStatusComputionFlags::Synchronizing;
-                    break;
-                case SyncthingDirStatus::WaitingToScan:
-                case SyncthingDirStatus::Scanning:
-                    scanning = m_statusComputionFlags & SyncthingStatusComputionFlags::Scanning;
-                    break;
-                default:;
-                }
-                if (synchronizing) {
-                    break; // skip remaining dirs, "synchronizing" overrides "scanning" anyways
-                }
-            }
+        // note: The number of directories/devices per status is maintained incrementally by the status tables
+        //       so this does not need to iterate over all directories and devices.
+#ifdef CPP_UTILITIES_DEBUG_BUILD
+        if (!areStatusCountersConsistent()) {
+            std::cerr << Phrases::Warning << "Status counters are inconsistent with directory/device info" << Phrases::EndFlush;
         }
+#endif
+        const auto &dirs = m_dirStatusTable;
+        const auto synchronizing = (m_statusComputionFlags & SyncthingStatusComputionFlags::Synchronizing)
+            && (dirs.hasStatus(SyncthingDirStatus::WaitingToSync) || dirs.hasStatus(SyncthingDirStatus::PreparingToSync)
+                || dirs.hasStatus(SyncthingDirStatus::Synchronizing));
+        const auto scanning = (m_statusComputionFlags & SyncthingStatusComputionFlags::Scanning)
+            && (dirs.hasStatus(SyncthingDirStatus::WaitingToScan) || dirs.hasStatus(SyncthingDirStatus::Scanning));
 
         // set the status to "remote synchronizing" if at least one remote device is still in progress
-        if (!synchronizing && (m_statusComputionFlags & SyncthingStatusComputionFlags::RemoteSynchronizing)) {
-            for (const SyncthingDev &dev : m_devs) {
-                if (dev.status == SyncthingDevStatus::Synchronizing) {
-                    remoteSynchronizing = true;
-                    break;
-                }
-            }
-        }
+        const auto remoteSynchronizing
+            = (m_statusComputionFlags & SyncthingStatusComputionFlags::RemoteSynchronizing) && m_devStatusTable.synchronizingCount();
 
         if (synchronizing) {
             status = SyncthingStatus::Synchronizing;
@@ -917,29 +1349,36 @@ void SyncthingConnection::setStatus(SyncthingStatus status)
             status = SyncthingStatus::RemoteNotInSync;
         } else if (scanning) {
             status = SyncthingStatus::Scanning;
-        } else if (m_statusComputionFlags & SyncthingStatusComputionFlags::DevicePaused) {
-            // check whether at least one device is paused
-            for (const SyncthingDev &dev : m_devs) {
-                if (dev.paused) {
-                    status = SyncthingStatus::Paused;
-                    break;
-                }
-            }
+        } else if ((m_statusComputionFlags & SyncthingStatusComputionFlags::DevicePaused) && m_devStatusTable.pausedCount()) {
+            // at least one device is paused
+            status = SyncthingStatus::Paused;
         }
     }
-    if (m_status != status) {
-        emit statusChanged(m_status = status);
+    if (m_status == status) {
+        return;
     }
+    switch (status) {
+    case SyncthingStatus::Scanning:
+    case SyncthingStatus::Synchronizing:
+    case SyncthingStatus::RemoteNotInSync:
+        handlePollingActivity();
+        break;
+    default:;
+    }
+    emit statusChanged(m_status = status);
 }
 
 /*!
  * \brief Internally called to emit a JSON parsing error.
- * \remarks Since in this case the reply has already been read, its response must be passed as extra argument.
+ * \remarks Since in this case the reply has already been read, its response must be passed as extra argument. The \a reply
+ *          might be nullptr if the response has not been received via the network (e.g. in tests).
  */
 void SyncthingConnection::emitError(const QString &message, const QJsonParseError &jsonError, QNetworkReply *reply, const QByteArray &response)
 {
+    // pass a deep copy as the response might only be a view of a pooled buffer (see attachReplyBuffer()) but receivers may keep it
     emit error(message % jsonError.errorString() % QChar(' ') % QChar('(') % tr("at offset %1").arg(jsonError.offset) % QChar(')'),
-        SyncthingErrorCategory::Parsing, QNetworkReply::NoError, reply->request(), response);
+        SyncthingErrorCategory::Parsing, QNetworkReply::NoError, reply ? reply->request() : QNetworkRequest(),
+        QByteArray(response.constData(), response.size()));
 }
 
 /*!
@@ -966,11 +1405,11 @@ void SyncthingConnection::emitMyIdChanged(const QString &newId)
             if (dev.status != SyncthingDevStatus::OwnDevice) {
                 dev.status = SyncthingDevStatus::OwnDevice;
                 dev.paused = false;
-                emit devStatusChanged(dev, row);
+                emitDevStatusChanged(dev, row);
             }
         } else if (dev.status == SyncthingDevStatus::OwnDevice) {
             dev.status = SyncthingDevStatus::Unknown;
-            emit devStatusChanged(dev, row);
+            emitDevStatusChanged(dev, row);
         }
         ++row;
     }
@@ -978,6 +1417,86 @@ void SyncthingConnection::emitMyIdChanged(const QString &newId)
     emit myIdChanged(m_myId = newId);
 }
 
+/*!
+ * \brief Internally called to emit dirStatusChanged() for the specified \a dir.
+ * \remarks
+ * - Updates the row of \a dir within dirStatusTable() right away.
+ * - Only marks \a dir as changed while reading a batch of events; flushStatusChanges() emits the signal at the end.
+ */
+void SyncthingConnection::emitDirStatusChanged(const SyncthingDir &dir, int index)
+{
+    m_dirStatusTable.update(dir, static_cast<std::size_t>(index));
+    if (m_batchingStatusChanges) {
+        m_changedDirs.emplace_back(index);
+    } else {
+        emit dirStatusChanged(dir, index);
+    }
+}
+
+/*!
+ * \brief Internally called to emit devStatusChanged() for the specified \a dev.
+ * \remarks
+ * - Updates the row of \a dev within the device status table right away.
+ * - Only marks \a dev as changed while reading a batch of events; flushStatusChanges() emits the signal at the end.
+ */
+void SyncthingConnection::emitDevStatusChanged(const SyncthingDev &dev, int index)
+{
+    m_devStatusTable.update(dev, static_cast<std::size_t>(index));
+    if (m_batchingStatusChanges) {
+        m_changedDevs.emplace_back(index);
+    } else {
+        emit devStatusChanged(dev, index);
+    }
+}
+
+/*!
+ * \brief Returns whether the counters of the status tables match the ones computed from scratch from the directory and device info.
+ * \remarks This is a self-check for the incremental updates of the counters. It iterates over all directories and devices
+ *          and is therefore only invoked by setStatus() in debug builds (and by tests).
+ */
+bool SyncthingConnection::areStatusCountersConsistent() const
+{
+    if (m_dirStatusTable.size() != m_dirs.size() || m_devStatusTable.size() != m_devs.size()) {
+        return false;
+    }
+    auto dirStatusCounts = std::array<std::size_t, static_cast<std::size_t>(SyncthingDirStatus::OutOfSync) + 1>();
+    for (const auto &dir : m_dirs) {
+        const auto index = static_cast<std::size_t>(dir.status);
+        ++dirStatusCounts[index < dirStatusCounts.size() ? index : static_cast<std::size_t>(SyncthingDirStatus::Unknown)];
+    }
+    for (auto index = std::size_t(); index != dirStatusCounts.size(); ++index) {
+        if (dirStatusCounts[index] != m_dirStatusTable.statusCount(static_cast<SyncthingDirStatus>(index))) {
+            return false;
+        }
+    }
+    auto synchronizingDevs = std::size_t(), pausedDevs = std::size_t();
+    for (const auto &dev : m_devs) {
+        synchronizingDevs += dev.status == SyncthingDevStatus::Synchronizing;
+        pausedDevs += dev.paused;
+    }
+    return synchronizingDevs == m_devStatusTable.synchronizingCount() && pausedDevs == m_devStatusTable.pausedCount();
+}
+
+/*!
+ * \brief Internally called to emit dirStatusChanged()/devStatusChanged() once per dir/dev changed within the current batch.
+ */
+void SyncthingConnection::flushStatusChanges()
+{
+    m_batchingStatusChanges = false;
+    const auto flush = [](std::vector<int> &changedIndices, auto &items, auto emitChanged) {
+        std::sort(changedIndices.begin(), changedIndices.end());
+        changedIndices.erase(std::unique(changedIndices.begin(), changedIndices.end()), changedIndices.end());
+        for (const auto index : changedIndices) {
+            if (index >= 0 && static_cast<std::size_t>(index) < items.size()) {
+                emitChanged(items[static_cast<std::size_t>(index)], index);
+            }
+        }
+        changedIndices.clear();
+    };
+    flush(m_changedDirs, m_dirs, [this](const SyncthingDir &dir, int index) { emit dirStatusChanged(dir, index); });
+    flush(m_changedDevs, m_devs, [this](const SyncthingDev &dev, int index) { emit devStatusChanged(dev, index); });
+}
+
 /*!
  * \brief Internally called to emit dirStatisticsChanged() event.
  */
@@ -989,6 +1508,48 @@ void SyncthingConnection::emitDirStatisticsChanged()
     }
 }
 
+/*!
+ * \brief Re-computes recentChangesMemoryUsage() from the changes recorded for all directories.
+ * \remarks Called when directories have been removed or their change buffers have been altered at once.
+ */
+void SyncthingConnection::updateRecentChangesMemoryUsage()
+{
+    m_recentChangesMemoryUsage = 0;
+    for (const auto &dir : m_dirs) {
+        m_recentChangesMemoryUsage += dir.recentChanges.memoryUsage();
+    }
+}
+
+/*!
+ * \brief Discards the oldest recorded file changes until recentChangesMemoryUsage() is within recentChangesMemoryBudget().
+ * \remarks
+ * - Changes of \a grownDir are discarded first, except its most recent change which the caller is about to pass to
+ *   fileChanged(). Usually only its oldest change needs to be discarded so this is O(1).
+ * - Only if that is not sufficient, changes of other directories are discarded.
+ */
+void SyncthingConnection::enforceRecentChangesMemoryBudget(SyncthingDir *grownDir)
+{
+    if (!m_recentChangesMemoryBudget) {
+        return;
+    }
+    const auto discardChanges = [this](SyncthingFileChangeBuffer &changes, std::size_t changesToKeep) {
+        while (m_recentChangesMemoryUsage > m_recentChangesMemoryBudget && changes.size() > changesToKeep) {
+            m_recentChangesMemoryUsage -= changes.popFront();
+        }
+    };
+    if (grownDir) {
+        discardChanges(grownDir->recentChanges, 1);
+    }
+    for (auto &dir : m_dirs) {
+        if (m_recentChangesMemoryUsage <= m_recentChangesMemoryBudget) {
+            break;
+        }
+        if (&dir != grownDir) {
+            discardChanges(dir.recentChanges, 0);
+        }
+    }
+}
+
 /*!
  * \brief Internally called to handle a fatal error when reading config (dirs/devs), status and events.
  */
@@ -1039,8 +1600,8 @@ void SyncthingConnection::recalculateStatus()
  * \brief Indicates new configuration (dirs, devs, ...) is available.
  * \remarks
  * - Configuration is requested automatically when connecting.
- * - Previous directories (and directory info objects!) are invalidated.
- * - Previous devices (and device info objects!) are invalidated.
+ * - If isResettingDirsAndDevs() returns true, previous directories and devices (and their info objects!) are
+ *   invalidated. Otherwise they are updated in place and only removed ones are invalidated.
  */
 
 /*!
@@ -1055,10 +1616,61 @@ void SyncthingConnection::recalculateStatus()
  * \remarks Always emitted after newConfig() as soon as new device info objects become available.
  */
 
+/*!
+ * \fn SyncthingConnection::dirsAboutToBeInserted()
+ * \brief Indicates directories are about to be inserted at the rows \a first to \a last.
+ * \remarks Only emitted when updating directories in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirsInserted()
+ * \brief Indicates directories have been inserted at the rows \a first to \a last.
+ * \remarks Only emitted when updating directories in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirsAboutToBeRemoved()
+ * \brief Indicates the directories at the rows \a first to \a last are about to be removed.
+ * \remarks Only emitted when updating directories in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirsRemoved()
+ * \brief Indicates the directories at the rows \a first to \a last have been removed.
+ * \remarks Only emitted when updating directories in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::devsAboutToBeInserted()
+ * \brief Indicates devices are about to be inserted at the rows \a first to \a last.
+ * \remarks Only emitted when updating devices in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::devsInserted()
+ * \brief Indicates devices have been inserted at the rows \a first to \a last.
+ * \remarks Only emitted when updating devices in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::devsAboutToBeRemoved()
+ * \brief Indicates the devices at the rows \a first to \a last are about to be removed.
+ * \remarks Only emitted when updating devices in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
+/*!
+ * \fn SyncthingConnection::devsRemoved()
+ * \brief Indicates the devices at the rows \a first to \a last have been removed.
+ * \remarks Only emitted when updating devices in place; not emitted if isResettingDirsAndDevs() returns true.
+ */
+
 /*!
  * \fn SyncthingConnection::newEvents()
  * \brief Indicates new events (dir status changed, ...) are available.
- * \remarks New events are automatically polled when connected.
+ * \remarks
+ * - New events are automatically polled when connected.
+ * - The events are only converted to a QJsonArray if this signal is actually connected. So only connect to it if
+ *   the raw JSON is really needed.
  */
 
 /*!
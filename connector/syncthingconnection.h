@@ -1,13 +1,20 @@
 #ifndef SYNCTHINGCONNECTION_H
 #define SYNCTHINGCONNECTION_H
 
+#include "./syncthingcompletionmatrix.h"
 #include "./syncthingconnectionstatus.h"
 #include "./syncthingdev.h"
+#include "./syncthingdevstatustable.h"
 #include "./syncthingdir.h"
+#include "./syncthingdirpathindex.h"
+#include "./syncthingdirstatustable.h"
+#include "./syncthingendpointstatistics.h"
+#include "./syncthingidtable.h"
 
 #include <c++utilities/misc/flagenumclass.h>
 
 #include <QByteArray>
+#include <QElapsedTimer>
 #include <QJsonObject>
 #include <QList>
 #include <QNetworkRequest>
@@ -15,9 +22,13 @@
 #include <QSslError>
 #include <QTimer>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <unordered_map>
 #include <vector>
 
 QT_FORWARD_DECLARE_CLASS(QNetworkAccessManager)
@@ -28,6 +39,7 @@ QT_FORWARD_DECLARE_CLASS(QJsonArray)
 QT_FORWARD_DECLARE_CLASS(QJsonParseError)
 
 class ConnectionTests;
+class ConnectionBenchmarks;
 class MiscTests;
 
 #define SYNCTHING_CONNECTOR_ENUM_CLASS enum class
@@ -39,6 +51,7 @@ SYNCTHING_CONNECTOR_ENUM_CLASS SyncthingStatusComputionFlags : quint64;
 namespace Data {
 
 struct SyncthingConnectionSettings;
+enum class SyncthingEventType : unsigned char;
 
 LIB_SYNCTHING_CONNECTOR_EXPORT QNetworkAccessManager &networkAccessManager();
 
@@ -52,6 +65,22 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingLogEntry {
     QString message;
 };
 
+/*!
+ * \brief The SyncthingRequestQueueStatistics struct holds metrics about the requests scheduled by SyncthingConnection.
+ * \remarks
+ * - Only requests which are sent in large numbers ("db/status" and "db/completion") are scheduled.
+ * - All times are in milliseconds.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingRequestQueueStatistics {
+    std::size_t queued = 0; /**< the number of requests currently waiting to be sent */
+    std::size_t maxQueued = 0; /**< the maximum number of requests which were waiting to be sent at the same time */
+    std::size_t inFlight = 0; /**< the number of requests currently being sent without having received a reply yet */
+    std::size_t completed = 0; /**< the number of requests which have been concluded (successfully or not) */
+    std::int64_t totalWaitTime = 0; /**< the accumulated time requests were waiting to be sent */
+    std::int64_t totalLatency = 0; /**< the accumulated time between sending requests and receiving their reply */
+    std::int64_t maxLatency = 0; /**< the maximum time between sending a request and receiving its reply */
+};
+
 enum class SyncthingConnectionLoggingFlags : quint64 {
     None, /**< loggingn is disabled */
     FromEnvironment = (1 << 0), /**< environment variables are checked to pull in any of the other flags dynamically */
@@ -70,6 +99,7 @@ namespace Data {
 
 class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnection : public QObject {
     friend ConnectionTests;
+    friend ConnectionBenchmarks;
     friend MiscTests;
 
     Q_OBJECT
@@ -90,6 +120,9 @@ class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnection : public QObject {
     Q_PROPERTY(unsigned int autoReconnectTries READ autoReconnectTries)
     Q_PROPERTY(int trafficPollInterval READ trafficPollInterval WRITE setTrafficPollInterval)
     Q_PROPERTY(int devStatsPollInterval READ devStatsPollInterval WRITE setDevStatsPollInterval)
+    Q_PROPERTY(int maxPollBackoffFactor READ maxPollBackoffFactor WRITE setMaxPollBackoffFactor)
+    Q_PROPERTY(int pollBackoffFactor READ pollBackoffFactor)
+    Q_PROPERTY(bool userInterfaceVisible READ isUserInterfaceVisible)
     Q_PROPERTY(bool recordFileChanges READ recordFileChanges WRITE setRecordFileChanges)
     Q_PROPERTY(QString myId READ myId NOTIFY myIdChanged)
     Q_PROPERTY(QString configDir READ configDir NOTIFY configDirChanged)
@@ -134,6 +167,7 @@ public:
     bool hasPendingRequestsIncludingEvents() const;
     bool hasUnreadNotifications() const;
     bool hasOutOfSyncDirs() const;
+    bool isResettingDirsAndDevs() const;
 
     // getter/setter to configure connection behavior
     bool isRequestingCompletionEnabled() const;
@@ -144,12 +178,37 @@ public:
     void setDevStatsPollInterval(int devStatsPollInterval);
     int errorsPollInterval() const;
     void setErrorsPollInterval(int errorsPollInterval);
+    int effectiveTrafficPollInterval() const;
+    int effectiveDevStatsPollInterval() const;
+    int effectiveErrorsPollInterval() const;
+    int maxPollBackoffFactor() const;
+    void setMaxPollBackoffFactor(int maxPollBackoffFactor);
+    int pollBackoffFactor() const;
+    bool isUserInterfaceVisible() const;
+    int visibleUserInterfaceCount() const;
+    void addVisibleUserInterface();
+    void removeVisibleUserInterface();
     int autoReconnectInterval() const;
     unsigned int autoReconnectTries() const;
     void setAutoReconnectInterval(int interval);
     void disablePolling();
     bool recordFileChanges() const;
     void setRecordFileChanges(bool recordFileChanges);
+    std::size_t recentChangesCapacity() const;
+    void setRecentChangesCapacity(std::size_t recentChangesCapacity);
+    std::size_t recentChangesMemoryBudget() const;
+    void setRecentChangesMemoryBudget(std::size_t recentChangesMemoryBudget);
+    std::size_t recentChangesMemoryUsage() const;
+    int maxConcurrentRequests() const;
+    void setMaxConcurrentRequests(int maxConcurrentRequests);
+    const SyncthingRequestQueueStatistics &requestQueueStatistics() const;
+    const SyncthingEndpointStatisticsMap &endpointStatistics() const;
+    void resetEndpointStatistics();
+    const QString &snapshotPath() const;
+    void setSnapshotPath(const QString &snapshotPath);
+    bool saveSnapshot() const;
+    bool loadSnapshot();
+    bool hasStaleDirsAndDevs() const;
 
     // getter for information retrieved from Syncthing
     const QString &configDir() const;
@@ -160,7 +219,15 @@ public:
     double totalOutgoingRate() const;
     static constexpr std::uint64_t unknownTraffic = std::numeric_limits<std::uint64_t>::max();
     const std::vector<SyncthingDir> &dirInfo() const;
+    const SyncthingDirStatusTable &dirStatusTable() const;
+    const SyncthingDirPathIndex &dirPathIndex() const;
     const std::vector<SyncthingDev> &devInfo() const;
+    const SyncthingDevStatusTable &devStatusTable() const;
+    const SyncthingIdTable &dirIds() const;
+    const SyncthingIdTable &devIds() const;
+    const SyncthingCompletionMatrix &completionMatrix() const;
+    const SyncthingCompletion *completion(const QString &dirId, const QString &devId) const;
+    bool areRemotesUpToDate(const QString &dirId) const;
     SyncthingOverallDirStatistics computeOverallDirStatistics() const;
     const QString &lastSyncedFile() const;
     CppUtilities::DateTime lastSyncTime() const;
@@ -236,6 +303,14 @@ Q_SIGNALS:
     void newDirs(const std::vector<SyncthingDir> &dirs);
     void newDevices(const std::vector<SyncthingDev> &devs);
     void newConfigApplied();
+    void dirsAboutToBeInserted(int first, int last);
+    void dirsInserted(int first, int last);
+    void dirsAboutToBeRemoved(int first, int last);
+    void dirsRemoved(int first, int last);
+    void devsAboutToBeInserted(int first, int last);
+    void devsInserted(int first, int last);
+    void devsAboutToBeRemoved(int first, int last);
+    void devsRemoved(int first, int last);
     void newEvents(const QJsonArray &events);
     void dirStatusChanged(const SyncthingDir &dir, int index);
     void devStatusChanged(const SyncthingDev &dev, int index);
@@ -263,11 +338,16 @@ Q_SIGNALS:
     void logAvailable(const std::vector<SyncthingLogEntry> &logEntries);
     void qrCodeAvailable(const QString &text, const QByteArray &qrCodeData);
 
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
 private Q_SLOTS:
     // handler to evaluate results from request...() methods
     void readConfig();
     void readDirs(const QJsonArray &dirs);
     void readDevs(const QJsonArray &devs);
+    void updateDirsAndDevs();
     void readStatus();
     void concludeReadingConfigAndStatus();
     void concludeConnection();
@@ -281,8 +361,8 @@ private Q_SLOTS:
     void readStartingEvent(const QJsonObject &eventData);
     void readStatusChangedEvent(CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     void readDownloadProgressEvent(CppUtilities::DateTime eventTime, const QJsonObject &eventData);
-    void readDirEvent(CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
-    void readDeviceEvent(CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
+    void readDirEvent(CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
+    void readDeviceEvent(CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
     void readItemStarted(CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     void readItemFinished(CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     void readFolderErrors(CppUtilities::DateTime eventTime, const QJsonObject &eventData, SyncthingDir &dirInfo, int index);
@@ -310,20 +390,34 @@ private Q_SLOTS:
     void readCompletion();
     void readVersion();
     void readDiskEvents();
-    void readChangeEvent(CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
+    void readChangeEvent(CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
     void readLog();
     void readQrCode();
+    void recordFirstByte();
+    void readIntoReplyBuffer();
+    void saveSnapshotIfUpToDate();
 
     // internal helper methods
     void continueConnecting();
     void continueReconnecting();
+    bool canResume() const;
+    void continueResuming(bool sameDevice, bool sameInstance);
+    void resyncDirsAndDevs();
+    void resyncDirs();
+    void restartEvents();
     void autoReconnect();
     void setStatus(SyncthingStatus status);
     void emitNotification(CppUtilities::DateTime when, const QString &message);
     void emitError(const QString &message, const QJsonParseError &jsonError, QNetworkReply *reply, const QByteArray &response = QByteArray());
     void emitError(const QString &message, SyncthingErrorCategory category, QNetworkReply *reply);
     void emitMyIdChanged(const QString &newId);
+    void emitDirStatusChanged(const SyncthingDir &dir, int index);
+    void emitDevStatusChanged(const SyncthingDev &dev, int index);
+    bool areStatusCountersConsistent() const;
+    void flushStatusChanges();
     void emitDirStatisticsChanged();
+    void updateRecentChangesMemoryUsage();
+    void enforceRecentChangesMemoryBudget(SyncthingDir *grownDir = nullptr);
     void handleFatalConnectionError();
     void handleAdditionalRequestCanceled();
     void recalculateStatus();
@@ -331,20 +425,63 @@ private Q_SLOTS:
 private:
     // internal helper methods
     struct Reply {
+        ~Reply();
         QNetworkReply *reply;
         QByteArray response;
     };
+    struct ReplyBuffer {
+        QByteArray data;
+        std::vector<QByteArray> *pool;
+    };
+    enum class RequestPriority { High, Normal, Low };
+    enum class ResumeState { None, CheckingStatus, CheckingConfig, CheckingEvents };
+    struct ScheduledRequest {
+        SyncthingIdTable::Handle dirHandle;
+        SyncthingIdTable::Handle devHandle; // only valid for completion requests
+        qint64 queuedAt;
+    };
     QNetworkRequest prepareRequest(const QString &path, const QUrlQuery &query, bool rest = true);
+    QNetworkRequest makeRequestTemplate(const QString &path, bool rest) const;
     QNetworkReply *requestData(const QString &path, const QUrlQuery &query, bool rest = true);
     QNetworkReply *postData(const QString &path, const QUrlQuery &query, const QByteArray &data = QByteArray());
+    QUrlQuery eventsQuery() const;
+    bool haveEventsBeenMissedWhenResuming(int sinceId, int firstId);
     Reply prepareReply(bool readData = true, bool handleAborting = true);
     Reply prepareReply(QNetworkReply *&expectedReply, bool readData = true, bool handleAborting = true);
     Reply prepareReply(QList<QNetworkReply *> &expectedReplies, bool readData = true, bool handleAborting = true);
     Reply handleReply(QNetworkReply *reply, bool readData, bool handleAborting);
+    void recordRequest(QNetworkReply *reply, const QString &path);
+    void attachReplyBuffer(QNetworkReply *reply, const QString &path);
+    void releaseReplyBuffer(const QObject *reply);
+    void updateEventFilter();
+    int scaledPollInterval(int pollInterval) const;
+    void startPollTimer(QTimer &pollTimer, int pollInterval);
+    void handlePollingActivity();
+    void scheduleRequest(RequestPriority priority, ScheduledRequest &&request);
+    void sendScheduledRequest(const ScheduledRequest &request);
+    void handleScheduledRequestFinished(QNetworkReply *reply);
+    void sendQueuedRequests();
+    void clearRequestQueue();
+    bool isDiskEventsPollingRequired() const;
+    void requestDiskEventsIfRequired();
+    bool readEventsFromResponse(const QByteArray &response, int &idVariable, bool emitNewEvents, const char *logContext, QJsonParseError &jsonError,
+        QNetworkReply *reply = nullptr, int *firstId = nullptr);
+    void readEvent(SyncthingEventType eventType, CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     bool pauseResumeDevice(const QStringList &devIds, bool paused);
     bool pauseResumeDirectory(const QStringList &dirIds, bool paused);
     SyncthingDir *addDirInfo(std::vector<SyncthingDir> &dirs, const QString &dirId);
+    SyncthingDir *findDirInfo(SyncthingIdTable::Handle dirHandle, int &row);
+    SyncthingDev *findDevInfo(SyncthingIdTable::Handle devHandle, int &row);
     SyncthingDev *addDevInfo(std::vector<SyncthingDev> &devs, const QString &devId);
+    bool assignDirConfig(SyncthingDir &dirInfo, const QJsonObject &dirObj);
+    bool assignDevConfig(SyncthingDev &devInfo, const QJsonObject &devObj);
+    bool isDirAndDevOrderRetained(const QJsonObject &newConfig) const;
+    QStringList updateDirs(const QJsonArray &dirs);
+    bool updateDevs(const QJsonArray &devs);
+    void pruneCompletion();
+    void indexDirs();
+    void indexDevs();
+    bool restoreSnapshot();
     CppUtilities::DateTime parseTimeStamp(const QJsonValue &jsonValue, const QString &context,
         CppUtilities::DateTime defaultValue = CppUtilities::DateTime(), bool greaterThanEpoch = false);
 
@@ -366,7 +503,16 @@ private:
     QTimer m_trafficPollTimer;
     QTimer m_devStatsPollTimer;
     QTimer m_errorsPollTimer;
+    QElapsedTimer m_pollActivityTimer;
+    int m_trafficPollInterval;
+    int m_devStatsPollInterval;
+    int m_errorsPollInterval;
+    int m_maxPollBackoffFactor;
+    int m_pollBackoffFactor;
+    int m_visibleUserInterfaces;
     QTimer m_autoReconnectTimer;
+    QTimer m_snapshotTimer;
+    QString m_snapshotPath;
     unsigned int m_autoReconnectTries;
     QString m_configDir;
     QString m_myId;
@@ -385,13 +531,29 @@ private:
     QNetworkReply *m_diskEventsReply;
     QNetworkReply *m_logReply;
     QList<QNetworkReply *> m_otherReplies;
+    std::array<std::deque<ScheduledRequest>, 3> m_requestQueue;
+    SyncthingRequestQueueStatistics m_requestQueueStats;
+    SyncthingEndpointStatisticsMap m_endpointStats;
+    std::unordered_map<QString, std::vector<QByteArray>> m_replyBufferPool;
+    std::unordered_map<const QObject *, ReplyBuffer> m_replyBuffers;
+    std::unordered_map<QString, QNetworkRequest> m_requestTemplates;
+    QElapsedTimer m_requestClock;
+    int m_maxConcurrentRequests;
     bool m_unreadNotifications;
     bool m_hasConfig;
     bool m_hasStatus;
     bool m_hasEvents;
     bool m_hasDiskEvents;
+    ResumeState m_resumeState;
+    std::size_t m_configHash;
     std::vector<SyncthingDir> m_dirs;
     std::vector<SyncthingDev> m_devs;
+    SyncthingIdTable m_dirIds;
+    SyncthingDirStatusTable m_dirStatusTable;
+    SyncthingDirPathIndex m_dirPathIndex;
+    SyncthingIdTable m_devIds;
+    SyncthingDevStatusTable m_devStatusTable;
+    SyncthingCompletionMatrix m_completion;
     CppUtilities::DateTime m_lastConnectionsUpdate;
     CppUtilities::DateTime m_lastFileTime;
     CppUtilities::DateTime m_lastErrorTime;
@@ -403,6 +565,15 @@ private:
     QJsonObject m_rawConfig;
     bool m_dirStatsAltered;
     bool m_recordFileChanges;
+    std::size_t m_recentChangesCapacity;
+    std::size_t m_recentChangesMemoryBudget;
+    std::size_t m_recentChangesMemoryUsage;
+    QString m_eventFilter;
+    bool m_batchingStatusChanges;
+    bool m_resettingDirsAndDevs;
+    bool m_hasStaleDirsAndDevs;
+    std::vector<int> m_changedDirs;
+    std::vector<int> m_changedDevs;
 };
 
 /*!
@@ -419,6 +590,7 @@ inline const QString &SyncthingConnection::syncthingUrl() const
 inline void SyncthingConnection::setSyncthingUrl(const QString &url)
 {
     m_syncthingUrl = url;
+    m_requestTemplates.clear();
 }
 
 /*!
@@ -435,6 +607,7 @@ inline const QByteArray &SyncthingConnection::apiKey() const
 inline void SyncthingConnection::setApiKey(const QByteArray &apiKey)
 {
     m_apiKey = apiKey;
+    m_requestTemplates.clear();
 }
 
 /*!
@@ -460,6 +633,7 @@ inline void SyncthingConnection::setCredentials(const QString &user, const QStri
 {
     m_user = user;
     m_password = password;
+    m_requestTemplates.clear();
 }
 
 /*!
@@ -503,7 +677,8 @@ inline bool SyncthingConnection::isConnected() const
 inline bool SyncthingConnection::hasPendingRequests() const
 {
     return m_abortingAllRequests || m_configReply || m_statusReply || (m_eventsReply && !m_hasEvents) || (m_diskEventsReply && !m_hasDiskEvents)
-        || m_connectionsReply || m_dirStatsReply || m_devStatsReply || m_errorsReply || m_versionReply || !m_otherReplies.isEmpty();
+        || m_connectionsReply || m_dirStatsReply || m_devStatsReply || m_errorsReply || m_versionReply || !m_otherReplies.isEmpty()
+        || m_requestQueueStats.queued;
 }
 
 /*!
@@ -516,21 +691,47 @@ inline bool SyncthingConnection::hasUnreadNotifications() const
 }
 
 /*!
- * \brief Returns whether completion for all directories of all devices should be requested automatically.
- * \remarks Completion can be requested manually using requestCompletion().
+ * \brief Returns whether the directories and devices are currently re-populated from scratch.
+ * \remarks
+ * - This is the case when the newConfig() signal has been emitted because the connection is (re)established or
+ *   the order of the existing directories/devices has changed within the configuration. The dirInfo() and devInfo()
+ *   vectors are then re-assigned before newConfigApplied() is emitted.
+ * - Otherwise the directories/devices are updated in place and insertions/removals are announced via the signals
+ *   dirsAboutToBeInserted(), dirsInserted(), dirsAboutToBeRemoved(), dirsRemoved() and their device counterparts.
+ * - Meant to be checked by handlers of newConfig() and newConfigApplied(), eg. to decide whether a model reset is required.
  */
-inline bool SyncthingConnection::isRequestingCompletionEnabled() const
+inline bool SyncthingConnection::isResettingDirsAndDevs() const
 {
-    return m_requestCompletion;
+    return m_resettingDirsAndDevs;
+}
+
+/*!
+ * \brief Returns the path of the file a snapshot of the directories and devices is persisted to.
+ * \remarks See setSnapshotPath() for details.
+ */
+inline const QString &SyncthingConnection::snapshotPath() const
+{
+    return m_snapshotPath;
 }
 
 /*!
- * \brief Sets whether completion for all directories of all devices should be requested automatically.
+ * \brief Returns whether dirInfo() and devInfo() have been restored from a snapshot (or kept from the previous connection
+ *        when reconnecting) and no configuration has been received from Syncthing yet.
+ * \remarks The status of restored directories and devices is SyncthingDirStatus::Unknown and SyncthingDevStatus::Unknown.
+ *          Statistics and completion are those from the time the snapshot has been taken.
+ */
+inline bool SyncthingConnection::hasStaleDirsAndDevs() const
+{
+    return m_hasStaleDirsAndDevs;
+}
+
+/*!
+ * \brief Returns whether completion for all directories of all devices should be requested automatically.
  * \remarks Completion can be requested manually using requestCompletion().
  */
-inline void SyncthingConnection::setRequestingCompletionEnabled(bool requestingCompletionEnabled)
+inline bool SyncthingConnection::isRequestingCompletionEnabled() const
 {
-    m_requestCompletion = requestingCompletionEnabled;
+    return m_requestCompletion;
 }
 
 /*!
@@ -558,7 +759,7 @@ inline void SyncthingConnection::considerAllNotificationsRead()
  */
 inline int SyncthingConnection::trafficPollInterval() const
 {
-    return m_trafficPollTimer.interval();
+    return m_trafficPollInterval;
 }
 
 /*!
@@ -570,7 +771,7 @@ inline void SyncthingConnection::setTrafficPollInterval(int trafficPollInterval)
     if (!trafficPollInterval) {
         m_trafficPollTimer.stop();
     }
-    m_trafficPollTimer.setInterval(trafficPollInterval);
+    m_trafficPollTimer.setInterval(scaledPollInterval(m_trafficPollInterval = trafficPollInterval));
 }
 
 /*!
@@ -579,7 +780,7 @@ inline void SyncthingConnection::setTrafficPollInterval(int trafficPollInterval)
  */
 inline int SyncthingConnection::devStatsPollInterval() const
 {
-    return m_devStatsPollTimer.interval();
+    return m_devStatsPollInterval;
 }
 
 /*!
@@ -591,7 +792,7 @@ inline void SyncthingConnection::setDevStatsPollInterval(int devStatsPollInterva
     if (!devStatsPollInterval) {
         m_devStatsPollTimer.stop();
     }
-    m_devStatsPollTimer.setInterval(devStatsPollInterval);
+    m_devStatsPollTimer.setInterval(scaledPollInterval(m_devStatsPollInterval = devStatsPollInterval));
 }
 
 /*!
@@ -600,7 +801,7 @@ inline void SyncthingConnection::setDevStatsPollInterval(int devStatsPollInterva
  */
 inline int SyncthingConnection::errorsPollInterval() const
 {
-    return m_errorsPollTimer.interval();
+    return m_errorsPollInterval;
 }
 
 /*!
@@ -612,7 +813,77 @@ inline void SyncthingConnection::setErrorsPollInterval(int errorPollInterval)
     if (!errorPollInterval) {
         m_errorsPollTimer.stop();
     }
-    m_errorsPollTimer.setInterval(errorPollInterval);
+    m_errorsPollTimer.setInterval(scaledPollInterval(m_errorsPollInterval = errorPollInterval));
+}
+
+/*!
+ * \brief Returns the interval traffic status is currently polled with in milliseconds.
+ * \remarks This is trafficPollInterval() multiplied by pollBackoffFactor().
+ */
+inline int SyncthingConnection::effectiveTrafficPollInterval() const
+{
+    return scaledPollInterval(m_trafficPollInterval);
+}
+
+/*!
+ * \brief Returns the interval device statistics are currently polled with in milliseconds.
+ * \remarks This is devStatsPollInterval() multiplied by pollBackoffFactor().
+ */
+inline int SyncthingConnection::effectiveDevStatsPollInterval() const
+{
+    return scaledPollInterval(m_devStatsPollInterval);
+}
+
+/*!
+ * \brief Returns the interval Syncthing errors are currently polled with in milliseconds.
+ * \remarks This is errorsPollInterval() multiplied by pollBackoffFactor().
+ */
+inline int SyncthingConnection::effectiveErrorsPollInterval() const
+{
+    return scaledPollInterval(m_errorsPollInterval);
+}
+
+/*!
+ * \brief Returns the factor the poll intervals are multiplied with at most while Syncthing is idling.
+ * \remarks For default value see SyncthingConnectionSettings. A value of one (or less) disables the backoff.
+ */
+inline int SyncthingConnection::maxPollBackoffFactor() const
+{
+    return m_maxPollBackoffFactor;
+}
+
+/*!
+ * \brief Returns the factor the poll intervals are currently multiplied with.
+ * \remarks See setMaxPollBackoffFactor() for details.
+ */
+inline int SyncthingConnection::pollBackoffFactor() const
+{
+    return m_pollBackoffFactor;
+}
+
+/*!
+ * \brief Returns whether a UI showing information about the connection is currently visible.
+ */
+inline bool SyncthingConnection::isUserInterfaceVisible() const
+{
+    return m_visibleUserInterfaces > 0;
+}
+
+/*!
+ * \brief Returns the number of UIs showing information about the connection which are currently visible.
+ * \sa addVisibleUserInterface() and removeVisibleUserInterface()
+ */
+inline int SyncthingConnection::visibleUserInterfaceCount() const
+{
+    return m_visibleUserInterfaces;
+}
+
+/*!
+ * \brief Returns the specified \a pollInterval multiplied by the current pollBackoffFactor().
+ */
+inline int SyncthingConnection::scaledPollInterval(int pollInterval) const
+{
+    return static_cast<int>(std::min<qint64>(static_cast<qint64>(pollInterval) * m_pollBackoffFactor, std::numeric_limits<int>::max()));
 }
 
 /*!
@@ -654,12 +925,57 @@ inline bool SyncthingConnection::recordFileChanges() const
 }
 
 /*!
- * \brief Returns whether file changes are recorded for each directory so SyncthingDir::recentChanges is being populated.
- * \remarks The fileChanged() signal is unaffected.
+ * \brief Returns the max. number of file changes recorded per directory if recordFileChanges() is enabled.
+ * \remarks For default value see SyncthingConnectionSettings. A value of 0 disables recording file changes.
+ */
+inline std::size_t SyncthingConnection::recentChangesCapacity() const
+{
+    return m_recentChangesCapacity;
+}
+
+/*!
+ * \brief Returns the max. number of bytes (approximately) file changes recorded across all directories may use.
+ * \remarks For default value see SyncthingConnectionSettings. A value of 0 indicates that the memory is not limited.
+ */
+inline std::size_t SyncthingConnection::recentChangesMemoryBudget() const
+{
+    return m_recentChangesMemoryBudget;
+}
+
+/*!
+ * \brief Returns the number of bytes (approximately) currently used by file changes recorded across all directories.
+ */
+inline std::size_t SyncthingConnection::recentChangesMemoryUsage() const
+{
+    return m_recentChangesMemoryUsage;
+}
+
+/*!
+ * \brief Returns the maximum number of scheduled requests which are sent concurrently.
+ * \remarks For default value see SyncthingConnectionSettings. A value of 0 indicates that the number is not limited.
+ */
+inline int SyncthingConnection::maxConcurrentRequests() const
+{
+    return m_maxConcurrentRequests;
+}
+
+/*!
+ * \brief Returns metrics about the requests scheduled so far.
  */
-inline void SyncthingConnection::setRecordFileChanges(bool recordFileChanges)
+inline const SyncthingRequestQueueStatistics &SyncthingConnection::requestQueueStatistics() const
 {
-    m_recordFileChanges = recordFileChanges;
+    return m_requestQueueStats;
+}
+
+/*!
+ * \brief Returns metrics about the requests made so far by REST-API path (e.g. "system/config").
+ * \remarks
+ * - The metrics are always recorded; the overhead is negligible compared to the requests themselves.
+ * - Parameters are not considered so e.g. all "db/status" requests are accounted for under the same path.
+ */
+inline const SyncthingEndpointStatisticsMap &SyncthingConnection::endpointStatistics() const
+{
+    return m_endpointStats;
 }
 
 /*!
@@ -747,6 +1063,24 @@ inline const std::vector<SyncthingDir> &SyncthingConnection::dirInfo() const
     return m_dirs;
 }
 
+/*!
+ * \brief Returns the status information of all directories which is scanned frequently; row i corresponds to dirInfo()[i].
+ * \remarks The table is kept in sync with dirInfo() and updated before dirStatusChanged() is emitted.
+ */
+inline const SyncthingDirStatusTable &SyncthingConnection::dirStatusTable() const
+{
+    return m_dirStatusTable;
+}
+
+/*!
+ * \brief Returns the index used by findDirInfoByPath() to look up the directory containing a path; rows correspond to dirInfo().
+ * \remarks The index is rebuilt before newDirs() is emitted.
+ */
+inline const SyncthingDirPathIndex &SyncthingConnection::dirPathIndex() const
+{
+    return m_dirPathIndex;
+}
+
 /*!
  * \brief Returns all available device information.
  * \remarks The returned object container object is persistent. However, the contained
@@ -757,12 +1091,63 @@ inline const std::vector<SyncthingDev> &SyncthingConnection::devInfo() const
     return m_devs;
 }
 
+/*!
+ * \brief Returns the status information of all devices; row i corresponds to devInfo()[i].
+ * \remarks The table is kept in sync with devInfo() and updated before devStatusChanged() is emitted.
+ */
+inline const SyncthingDevStatusTable &SyncthingConnection::devStatusTable() const
+{
+    return m_devStatusTable;
+}
+
+/*!
+ * \brief Returns the table of interned directory IDs; used to map the directory handles of completionMatrix() to IDs.
+ */
+inline const SyncthingIdTable &SyncthingConnection::dirIds() const
+{
+    return m_dirIds;
+}
+
+/*!
+ * \brief Returns the table of interned device IDs; used to map the device handles of completionMatrix() to IDs.
+ */
+inline const SyncthingIdTable &SyncthingConnection::devIds() const
+{
+    return m_devIds;
+}
+
+/*!
+ * \brief Returns the completion of all directories on all remote devices.
+ * \remarks The matrix is indexed by the handles of dirIds() and devIds().
+ */
+inline const SyncthingCompletionMatrix &SyncthingConnection::completionMatrix() const
+{
+    return m_completion;
+}
+
+/*!
+ * \brief Returns the completion of the directory with the specified \a dirId on the device with the specified \a devId.
+ * \returns Returns nullptr if the completion is not known.
+ */
+inline const SyncthingCompletion *SyncthingConnection::completion(const QString &dirId, const QString &devId) const
+{
+    return m_completion.find(m_dirIds.handle(dirId), m_devIds.handle(devId));
+}
+
+/*!
+ * \brief Returns whether the directory with the specified \a dirId is up-to-date on all remote devices its completion is known for.
+ */
+inline bool SyncthingConnection::areRemotesUpToDate(const QString &dirId) const
+{
+    return m_completion.areRemotesUpToDate(m_dirIds.handle(dirId));
+}
+
 /*!
  * \brief Computes overall directory statistics based on the currently available directory information.
  */
 inline SyncthingOverallDirStatistics SyncthingConnection::computeOverallDirStatistics() const
 {
-    return SyncthingOverallDirStatistics(dirInfo());
+    return SyncthingOverallDirStatistics(m_dirStatusTable);
 }
 
 /*!
@@ -1,4 +1,5 @@
 #include "./syncthingconnection.h"
+#include "./syncthingevents.h"
 #include "./utils.h"
 
 #ifdef LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED
@@ -9,16 +10,22 @@
 #include <c++utilities/conversion/stringconversion.h>
 #include <c++utilities/io/ansiescapecodes.h>
 
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonValue>
+#include <QMetaMethod>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QStringBuilder>
 #include <QTimer>
 #include <QUrlQuery>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <unordered_set>
 #include <utility>
 
 using namespace std;
@@ -27,18 +34,103 @@ using namespace CppUtilities::EscapeCodes;
 
 namespace Data {
 
+/// \cond
+static std::uint64_t monotonicMicroseconds()
+{
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+}
+
+static SyncthingEndpointStatistics *endpointStatistics(const QNetworkReply *reply)
+{
+    return reply ? static_cast<SyncthingEndpointStatistics *>(reply->property("endpointStats").value<void *>()) : nullptr;
+}
+
+/*!
+ * \brief Returns whether replies for the specified REST-API \a path are read into pooled buffers.
+ * \remarks Only endpoints which are polled repeatedly are considered. Their handlers must not retain the response beyond
+ *          their own invocation because it is only a view of the pooled buffer.
+ */
+static bool isReplyBufferPooled(const QString &path)
+{
+    return path == QLatin1String("events") || path == QLatin1String("events/disk") || path == QLatin1String("system/connections")
+        || path == QLatin1String("system/error") || path == QLatin1String("stats/device") || path == QLatin1String("stats/folder")
+        || path == QLatin1String("db/status") || path == QLatin1String("db/completion");
+}
+
+/// \brief The maximum number of idle buffers kept per endpoint.
+constexpr auto maxPooledReplyBuffers = std::size_t(8);
+/// \brief The maximum capacity of buffers which are returned to the pool; bigger buffers are freed to not waste memory.
+constexpr auto maxPooledReplyBufferCapacity = qint64(4 * 1024 * 1024);
+
+/*!
+ * \brief Appends the data available from \a reply to \a buffer without intermediate allocations.
+ */
+static void appendToReplyBuffer(QNetworkReply *reply, QByteArray &buffer)
+{
+    for (auto available = reply->bytesAvailable(); available > 0; available = reply->bytesAvailable()) {
+        const auto size = buffer.size();
+        buffer.resize(size + static_cast<decltype(size)>(available));
+        const auto read = reply->read(buffer.data() + size, available);
+        buffer.resize(size + static_cast<decltype(size)>(std::max<qint64>(read, 0)));
+        if (read <= 0) {
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief Parses the specified \a response of \a reply as JSON document and records the time it took.
+ */
+static QJsonDocument parseJsonReply(const QNetworkReply *reply, const QByteArray &response, QJsonParseError &error)
+{
+    const auto startedAt = monotonicMicroseconds();
+    auto document = QJsonDocument::fromJson(response, &error);
+    if (auto *const stats = endpointStatistics(reply)) {
+        stats->parseTime.record(monotonicMicroseconds() - startedAt);
+    }
+    return document;
+}
+/// \endcond
+
 // helper to create QNetworkRequest
 
 /*!
  * \brief Prepares a request for the specified \a path and \a query.
+ * \remarks
+ * - Requests for REST-API endpoints are derived from a template cached per \a path so the URL does not need to be parsed
+ *   and the headers do not need to be set again for every request. The templates are discarded when the URL, the API key
+ *   or the credentials are changed.
+ * - Copying the template is cheap as QNetworkRequest and QUrl are implicitly shared. Only the URL is detached if a \a query
+ *   needs to be set.
  */
 QNetworkRequest SyncthingConnection::prepareRequest(const QString &path, const QUrlQuery &query, bool rest)
+{
+    auto request = QNetworkRequest();
+    if (!rest) {
+        request = makeRequestTemplate(path, false);
+    } else if (auto &requestTemplate = m_requestTemplates[path]; !requestTemplate.url().isEmpty()) {
+        request = requestTemplate;
+    } else {
+        request = requestTemplate = makeRequestTemplate(path, true);
+    }
+    if (!query.isEmpty()) {
+        auto url = request.url();
+        url.setQuery(query);
+        request.setUrl(url);
+    }
+    return request;
+}
+
+/*!
+ * \brief Makes a request for the specified \a path without query; used by prepareRequest().
+ */
+QNetworkRequest SyncthingConnection::makeRequestTemplate(const QString &path, bool rest) const
 {
     QUrl url(m_syncthingUrl);
     url.setPath(rest ? (url.path() % QStringLiteral("/rest/") % path) : (url.path() + path));
     url.setUserName(user());
     url.setPassword(password());
-    url.setQuery(query);
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArray("application/x-www-form-urlencoded"));
     request.setRawHeader("X-API-Key", m_apiKey);
@@ -56,10 +148,14 @@ QNetworkReply *SyncthingConnection::requestData(const QString &path, const QUrlQ
         cerr << Phrases::Info << "Querying API: GET " << reply->url().toString().toStdString() << Phrases::EndFlush;
     }
     reply->ignoreSslErrors(m_expectedSslErrors);
-    return reply;
 #else
-    return MockedReply::forRequest(QStringLiteral("GET"), path, query, rest);
+    auto *const reply = MockedReply::forRequest(QStringLiteral("GET"), path, query, rest);
 #endif
+    recordRequest(reply, path);
+    if (isReplyBufferPooled(path)) {
+        attachReplyBuffer(reply, path);
+    }
+    return reply;
 }
 
 /*!
@@ -72,9 +168,112 @@ QNetworkReply *SyncthingConnection::postData(const QString &path, const QUrlQuer
         cerr << Phrases::Info << "Querying API: POST " << reply->url().toString().toStdString() << Phrases::EndFlush;
     }
     reply->ignoreSslErrors(m_expectedSslErrors);
+    recordRequest(reply, path);
     return reply;
 }
 
+/*!
+ * \brief Records that a request for the specified REST-API \a path has been sent via \a reply.
+ * \remarks The statistics for the path are attached to the reply so further metrics can be recorded without lookup
+ *          when the reply is handled. This is safe because entries of m_endpointStats are never removed.
+ */
+void SyncthingConnection::recordRequest(QNetworkReply *reply, const QString &path)
+{
+    auto &stats = m_endpointStats[path];
+    ++stats.requests;
+    reply->setProperty("endpointStats", QVariant::fromValue(static_cast<void *>(&stats)));
+    reply->setProperty("requestedAt", QVariant::fromValue(monotonicMicroseconds()));
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, this, &SyncthingConnection::recordFirstByte);
+}
+
+/*!
+ * \brief Makes \a reply read its response incrementally into a buffer taken from the pool of the REST-API \a path.
+ * \remarks
+ * - The buffer is handed to the handler as non-owning view (see handleReply()) and returned to the pool when \a reply is
+ *   destroyed. So repeated polls of the same endpoint re-use the memory of previous responses instead of allocating a
+ *   new QByteArray each time.
+ * - The pool is never shrunk below the number of buffers needed concurrently (bounded by maxPooledReplyBuffers).
+ */
+void SyncthingConnection::attachReplyBuffer(QNetworkReply *reply, const QString &path)
+{
+    auto &pool = m_replyBufferPool[path];
+    auto &buffer = m_replyBuffers[reply];
+    buffer.pool = &pool;
+    if (!pool.empty()) {
+        buffer.data.swap(pool.back());
+        pool.pop_back();
+    }
+    QObject::connect(reply, &QIODevice::readyRead, this, &SyncthingConnection::readIntoReplyBuffer);
+    QObject::connect(reply, &QObject::destroyed, this, &SyncthingConnection::releaseReplyBuffer);
+}
+
+/*!
+ * \brief Reads the data available from the reply which has emitted QIODevice::readyRead() into its pooled buffer.
+ */
+void SyncthingConnection::readIntoReplyBuffer()
+{
+    auto *const reply = static_cast<QNetworkReply *>(sender());
+    if (const auto buffer = m_replyBuffers.find(reply); buffer != m_replyBuffers.end()) {
+        appendToReplyBuffer(reply, buffer->second.data);
+    }
+}
+
+/*!
+ * \brief Returns the buffer of the specified \a reply to the pool; invoked when the reply has been destroyed.
+ */
+void SyncthingConnection::releaseReplyBuffer(const QObject *reply)
+{
+    const auto buffer = m_replyBuffers.find(reply);
+    if (buffer == m_replyBuffers.end()) {
+        return;
+    }
+    auto &[data, pool] = buffer->second;
+    if (pool->size() < maxPooledReplyBuffers && static_cast<qint64>(data.capacity()) <= maxPooledReplyBufferCapacity) {
+        // mark the capacity as reserved so it is kept when truncating
+        data.reserve(data.capacity());
+        data.resize(0);
+        pool->emplace_back(std::move(data));
+    }
+    m_replyBuffers.erase(buffer);
+}
+
+/*!
+ * \brief Records the time to first byte of the reply which has emitted QNetworkReply::metaDataChanged().
+ */
+void SyncthingConnection::recordFirstByte()
+{
+    auto *const reply = static_cast<QNetworkReply *>(sender());
+    if (!reply->property("firstByteAt").isValid()) {
+        reply->setProperty("firstByteAt", QVariant::fromValue(monotonicMicroseconds()));
+    }
+}
+
+/*!
+ * \brief Resets the metrics returned by endpointStatistics().
+ */
+void SyncthingConnection::resetEndpointStatistics()
+{
+    for (auto &[path, stats] : m_endpointStats) {
+        stats = SyncthingEndpointStatistics();
+    }
+}
+
+/*!
+ * \brief Records the time spent within the handler of the reply (if any).
+ * \remarks The reply is destroyed when the handler returns as handlers bind it via "auto const [reply, response]".
+ */
+SyncthingConnection::Reply::~Reply()
+{
+    if (!reply) {
+        return;
+    }
+    auto *const stats = endpointStatistics(reply);
+    const auto handlerStartedAt = reply->property("handlerStartedAt");
+    if (stats && handlerStartedAt.isValid()) {
+        stats->handlerTime.record(monotonicMicroseconds() - handlerStartedAt.value<std::uint64_t>());
+    }
+}
+
 /*!
  * \brief Prepares the current reply.
  */
@@ -101,7 +300,10 @@ SyncthingConnection::Reply SyncthingConnection::prepareReply(QNetworkReply *&exp
 SyncthingConnection::Reply SyncthingConnection::prepareReply(QList<QNetworkReply *> &expectedReplies, bool readData, bool handleAborting)
 {
     auto *const reply = static_cast<QNetworkReply *>(sender());
-    expectedReplies.removeAll(reply); // unset the expected reply so it is no longer considered pending
+    // unset the expected reply so it is no longer considered pending
+    if (expectedReplies.removeAll(reply) && reply->property("sentAt").isValid()) {
+        handleScheduledRequestFinished(reply);
+    }
     return handleReply(reply, readData, handleAborting);
 }
 
@@ -111,29 +313,53 @@ SyncthingConnection::Reply SyncthingConnection::prepareReply(QList<QNetworkReply
 SyncthingConnection::Reply SyncthingConnection::handleReply(QNetworkReply *reply, bool readData, bool handleAborting)
 {
     const auto log = m_loggingFlags & SyncthingConnectionLoggingFlags::ApiReplies;
+    const auto bytesAvailable = reply->isOpen() ? reply->bytesAvailable() : 0;
     readData = (readData || log) && reply->isOpen();
     handleAborting = handleAborting && m_abortingAllRequests;
-    const auto data = Reply{
-        .reply = handleAborting ? nullptr : reply, // skip further processing if aborting to reconnect
-        .response = readData ? reply->readAll() : QByteArray(),
-    };
+    auto response = QByteArray();
+    if (const auto buffer = readData ? m_replyBuffers.find(reply) : m_replyBuffers.end(); buffer != m_replyBuffers.end()) {
+        // hand out a view of the pooled buffer which is only released when the reply is destroyed (after the handler returned)
+        appendToReplyBuffer(reply, buffer->second.data);
+        response = QByteArray::fromRawData(buffer->second.data.constData(), buffer->second.data.size());
+    } else if (readData) {
+        response = reply->readAll();
+    }
     reply->deleteLater();
 
+    // record metrics
+    if (auto *const stats = endpointStatistics(reply)) {
+        const auto now = monotonicMicroseconds();
+        const auto requestedAt = reply->property("requestedAt").value<std::uint64_t>();
+        const auto firstByteAt = reply->property("firstByteAt");
+        ++stats->replies;
+        if (reply->error() != QNetworkReply::NoError) {
+            ++stats->errors;
+        }
+        stats->latency.record(now - requestedAt);
+        stats->timeToFirstByte.record((firstByteAt.isValid() ? firstByteAt.value<std::uint64_t>() : now) - requestedAt);
+        stats->responseSize.record(static_cast<std::uint64_t>(readData ? response.size() : std::max<qint64>(bytesAvailable, 0)));
+        reply->setProperty("handlerStartedAt", QVariant::fromValue(now));
+    }
+
     if (log) {
         const auto url = reply->url();
-        const auto path = url.path().toUtf8();
+        const auto path = url.path();
         const auto urlStr = url.toString().toUtf8();
         cerr << Phrases::Info << "Received reply for: " << std::string_view(urlStr.data(), static_cast<std::string_view::size_type>(urlStr.size()))
              << Phrases::EndFlush;
-        if (!data.response.isEmpty() && path != "/rest/events"
-            && path != "/rest/events/disk") { // events are logged separately because they are not always useful but make the log very verbose
-            cerr << std::string_view(data.response.data(), static_cast<std::string_view::size_type>(data.response.size()));
+        // note: Events are logged separately because they are not always useful but make the log very verbose.
+        if (!response.isEmpty() && path != QLatin1String("/rest/events") && path != QLatin1String("/rest/events/disk")) {
+            cerr << std::string_view(response.constData(), static_cast<std::string_view::size_type>(response.size()));
         }
     }
     if (handleAborting) {
         handleAdditionalRequestCanceled();
     }
-    return data;
+    // return a prvalue so the reply is not copied (its destructor records the handler time)
+    return Reply{
+        .reply = handleAborting ? nullptr : reply, // skip further processing if aborting to reconnect
+        .response = std::move(response),
+    };
 }
 
 // pause/resume devices
@@ -520,15 +746,32 @@ void SyncthingConnection::readConfig()
 
     switch (reply->error()) {
     case QNetworkReply::NoError: {
+        // keep dirs/devs when resuming after Syncthing has been restarted with the same config
+        const auto configHash = static_cast<std::size_t>(qHash(response));
+        if (m_resumeState == ResumeState::CheckingConfig) {
+            m_resumeState = ResumeState::None;
+            if (configHash == m_configHash) {
+                m_hasConfig = true;
+                continueConnecting();
+                return;
+            }
+        }
+        m_configHash = configHash;
+
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse Syncthing config: "), jsonError, reply, response);
             handleFatalConnectionError();
             return;
         }
 
-        m_rawConfig = replyDoc.object();
+        // update dirs/devs only in place if the connection has already been established (or dirs/devs have been restored
+        // from a snapshot) and the order is retained
+        auto config = replyDoc.object();
+        m_resettingDirsAndDevs
+            = m_hasStaleDirsAndDevs ? !isDirAndDevOrderRetained(config) : (!m_hasConfig || !m_hasStatus || !isDirAndDevOrderRetained(config));
+        m_rawConfig = std::move(config);
         m_hasConfig = true;
         emit newConfig(m_rawConfig);
 
@@ -537,8 +780,12 @@ void SyncthingConnection::readConfig()
             return;
         }
 
-        readDevs(m_rawConfig.value(QLatin1String("devices")).toArray());
-        readDirs(m_rawConfig.value(QLatin1String("folders")).toArray());
+        if (m_resettingDirsAndDevs) {
+            readDevs(m_rawConfig.value(QLatin1String("devices")).toArray());
+            readDirs(m_rawConfig.value(QLatin1String("folders")).toArray());
+        } else {
+            updateDirsAndDevs();
+        }
         emit newConfigApplied();
         break;
     }
@@ -557,6 +804,7 @@ void SyncthingConnection::readConfig()
  *   So when parsing the config, readDevs() should be called first.
  * - The own device ID is required to filter it from the devices a directory is shared with.
  *   So the readStatus() should have been called first.
+ * - Re-assigns m_dirs completely. If the connection has already been established, updateDirs() is used instead.
  */
 void SyncthingConnection::readDirs(const QJsonArray &dirs)
 {
@@ -564,45 +812,24 @@ void SyncthingConnection::readDirs(const QJsonArray &dirs)
     std::vector<SyncthingDir> newDirs;
     newDirs.reserve(static_cast<size_t>(dirs.size()));
 
-    int dummy;
     for (const QJsonValue &dirVal : dirs) {
         const QJsonObject dirObj(dirVal.toObject());
-        SyncthingDir *const dirItem = addDirInfo(newDirs, dirObj.value(QLatin1String("id")).toString());
-        if (!dirItem) {
-            continue;
+        if (SyncthingDir *const dirItem = addDirInfo(newDirs, dirObj.value(QLatin1String("id")).toString())) {
+            assignDirConfig(*dirItem, dirObj);
         }
-
-        dirItem->label = dirObj.value(QLatin1String("label")).toString();
-        dirItem->path = dirObj.value(QLatin1String("path")).toString();
-        dirItem->deviceIds.clear();
-        dirItem->deviceNames.clear();
-        for (const QJsonValueRef devObj : dirObj.value(QLatin1String("devices")).toArray()) {
-            const QString devId = devObj.toObject().value(QLatin1String("deviceID")).toString();
-            if (devId.isEmpty() || devId == m_myId) {
-                continue;
-            }
-            dirItem->deviceIds << devId;
-            if (const SyncthingDev *const dev = findDevInfo(devId, dummy)) {
-                dirItem->deviceNames << dev->name;
-            }
-        }
-        dirItem->assignDirType(dirObj.value(QLatin1String("type")).toString());
-        dirItem->rescanInterval = dirObj.value(QLatin1String("rescanIntervalS")).toInt(-1);
-        dirItem->ignorePermissions = dirObj.value(QLatin1String("ignorePerms")).toBool(false);
-        dirItem->ignoreDelete = dirObj.value(QLatin1String("ignoreDelete")).toBool(false);
-        dirItem->autoNormalize = dirObj.value(QLatin1String("autoNormalize")).toBool(false);
-        dirItem->minDiskFreePercentage = dirObj.value(QLatin1String("minDiskFreePct")).toInt(-1);
-        dirItem->paused = dirObj.value(QLatin1String("paused")).toBool(dirItem->paused);
-        dirItem->fileSystemWatcherEnabled = dirObj.value(QLatin1String("fsWatcherEnabled")).toBool(false);
-        dirItem->fileSystemWatcherDelay = dirObj.value(QLatin1String("fsWatcherDelayS")).toDouble(0.0);
     }
 
     m_dirs.swap(newDirs);
+    m_hasStaleDirsAndDevs = false;
+    m_completion.clear();
+    indexDirs();
+    updateRecentChangesMemoryUsage();
     emit this->newDirs(m_dirs);
 }
 
 /*!
  * \brief Reads device results of requestConfig(); called by readConfig().
+ * \remarks Re-assigns m_devs completely. If the connection has already been established, updateDevs() is used instead.
  */
 void SyncthingConnection::readDevs(const QJsonArray &devs)
 {
@@ -612,27 +839,336 @@ void SyncthingConnection::readDevs(const QJsonArray &devs)
 
     for (const QJsonValue &devVal : devs) {
         const QJsonObject devObj(devVal.toObject());
-        SyncthingDev *const devItem = addDevInfo(newDevs, devObj.value(QLatin1String("deviceID")).toString());
-        if (!devItem) {
+        if (SyncthingDev *const devItem = addDevInfo(newDevs, devObj.value(QLatin1String("deviceID")).toString())) {
+            devItem->status = SyncthingDevStatus::Unknown;
+            assignDevConfig(*devItem, devObj);
+        }
+    }
+
+    m_devs.swap(newDevs);
+    m_completion.clear();
+    indexDevs();
+    emit this->newDevices(m_devs);
+}
+
+/*!
+ * \brief Updates directories and devices in place from the current config; called by readConfig() instead of
+ *        readDevs() and readDirs() if isResettingDirsAndDevs() returns false.
+ * \remarks When polling, the status of inserted/altered directories (and their completion) as well as the connections
+ *          of inserted/altered devices are requested because continueConnecting() is not invoked in this case.
+ */
+void SyncthingConnection::updateDirsAndDevs()
+{
+    m_hasStaleDirsAndDevs = false;
+    const auto devsChanged = updateDevs(m_rawConfig.value(QLatin1String("devices")).toArray());
+    const auto changedDirs = updateDirs(m_rawConfig.value(QLatin1String("folders")).toArray());
+    pruneCompletion();
+    emit newDevices(m_devs);
+    emit newDirs(m_dirs);
+
+    if (!m_keepPolling) {
+        return;
+    }
+    if (devsChanged) {
+        requestConnections();
+        requestDeviceStatistics();
+    }
+    if (changedDirs.isEmpty()) {
+        return;
+    }
+    requestDirStatistics();
+    for (const auto &dirId : changedDirs) {
+        int row;
+        const auto *const dirInfo = findDirInfo(dirId, row);
+        requestDirStatus(dirId);
+        if (!m_requestCompletion || !dirInfo || dirInfo->paused) {
             continue;
         }
+        for (const auto &devId : dirInfo->deviceIds) {
+            requestCompletion(devId, dirId);
+        }
+    }
+}
+
+/*!
+ * \brief Removes the completion of directories and devices which are not present anymore; called by updateDirsAndDevs().
+ * \remarks Updates the overall completion of the remaining devices accordingly.
+ */
+void SyncthingConnection::pruneCompletion()
+{
+    m_completion.removeIf([this](SyncthingIdTable::Handle dirHandle, SyncthingIdTable::Handle devHandle) {
+        return m_dirIds.row(dirHandle) == SyncthingIdTable::noRow || m_devIds.row(devHandle) == SyncthingIdTable::noRow;
+    });
+    for (auto &dev : m_devs) {
+        dev.overallCompletion = m_completion.overallCompletionOfDev(m_devIds.handle(dev.id));
+    }
+}
 
-        devItem->name = devObj.value(QLatin1String("name")).toString();
-        devItem->addresses = things(devObj.value(QLatin1String("addresses")).toArray(), [](const QJsonValue &value) { return value.toString(); });
-        devItem->compression = devObj.value(QLatin1String("compression")).toString();
-        devItem->certName = devObj.value(QLatin1String("certName")).toString();
-        devItem->introducer = devObj.value(QLatin1String("introducer")).toBool(false);
-        if (devItem->id == m_myId) {
-            devItem->status = SyncthingDevStatus::OwnDevice;
-            devItem->paused = false;
+/*!
+ * \brief Updates m_dirs in place from the specified \a dirs; called by updateDirsAndDevs().
+ * \remarks
+ * - Requires the relative order of directories which are already present to be retained; see isDirAndDevOrderRetained().
+ * - Emits dirsAboutToBeRemoved()/dirsRemoved() and dirsAboutToBeInserted()/dirsInserted() once per contiguous range of
+ *   removed/inserted directories and dirStatusChanged() for directories whose configuration has been altered.
+ * - The index is only rebuilt once after all removals and insertions (so it is not up-to-date yet when the signals for
+ *   removals and insertions are emitted) and before dirStatusChanged() is emitted. The same goes for the path index
+ *   which is also rebuilt if only the configuration of existing directories has been altered.
+ * \returns Returns the IDs of the directories which have been inserted or altered.
+ */
+QStringList SyncthingConnection::updateDirs(const QJsonArray &dirs)
+{
+    // remove directories which are not present anymore (starting from the back so rows of preceding directories are retained)
+    auto newIds = std::unordered_set<QString>();
+    newIds.reserve(static_cast<std::size_t>(dirs.size()));
+    for (const auto &dirVal : dirs) {
+        newIds.emplace(dirVal.toObject().value(QLatin1String("id")).toString());
+    }
+    const auto isRemoved = [this, &newIds](int row) { return newIds.find(m_dirs[static_cast<std::size_t>(row)].id) == newIds.end(); };
+    auto reindex = false;
+    for (auto last = static_cast<int>(m_dirs.size()) - 1; last >= 0; --last) {
+        if (!isRemoved(last)) {
+            continue;
+        }
+        auto first = last;
+        for (; first > 0 && isRemoved(first - 1); --first)
+            ;
+        emit dirsAboutToBeRemoved(first, last);
+        m_dirs.erase(m_dirs.begin() + first, m_dirs.begin() + last + 1);
+        emit dirsRemoved(first, last);
+        last = first;
+        reindex = true;
+    }
+    updateRecentChangesMemoryUsage();
+
+    // update existing directories and insert new ones (collecting contiguous new directories to insert them at once)
+    auto changedDirs = QStringList();
+    auto alteredRows = std::vector<int>();
+    auto newDirs = std::vector<SyncthingDir>();
+    auto row = 0;
+    const auto insertNewDirs = [this, &newDirs, &row, &reindex] {
+        if (newDirs.empty()) {
+            return;
+        }
+        const auto last = row + static_cast<int>(newDirs.size()) - 1;
+        emit dirsAboutToBeInserted(row, last);
+        m_dirs.insert(m_dirs.begin() + row, std::make_move_iterator(newDirs.begin()), std::make_move_iterator(newDirs.end()));
+        emit dirsInserted(row, last);
+        row = last + 1;
+        newDirs.clear();
+        reindex = true;
+    };
+    for (const auto &dirVal : dirs) {
+        const auto dirObj = dirVal.toObject();
+        auto dirId = dirObj.value(QLatin1String("id")).toString();
+        if (dirId.isEmpty()) {
+            continue;
+        }
+        if (const auto index = static_cast<std::size_t>(row); index < m_dirs.size() && m_dirs[index].id == dirId) {
+            insertNewDirs();
+            if (assignDirConfig(m_dirs[static_cast<std::size_t>(row)], dirObj)) {
+                alteredRows.emplace_back(row);
+                changedDirs << std::move(dirId);
+            }
+            ++row;
         } else {
-            devItem->status = SyncthingDevStatus::Unknown;
-            devItem->paused = devObj.value(QLatin1String("paused")).toBool(devItem->paused);
+            assignDirConfig(newDirs.emplace_back(dirId), dirObj);
+            changedDirs << std::move(dirId);
         }
     }
+    insertNewDirs();
+    if (reindex) {
+        indexDirs();
+    } else if (!alteredRows.empty()) {
+        m_dirPathIndex.assign(m_dirs); // paths of existing directories might have been altered
+    }
+    for (const auto alteredRow : alteredRows) {
+        emitDirStatusChanged(m_dirs[static_cast<std::size_t>(alteredRow)], alteredRow);
+    }
+    return changedDirs;
+}
 
-    m_devs.swap(newDevs);
-    emit this->newDevices(m_devs);
+/*!
+ * \brief Updates m_devs in place from the specified \a devs; called by updateDirsAndDevs().
+ * \remarks
+ * - Requires the relative order of devices which are already present to be retained; see isDirAndDevOrderRetained().
+ * - Emits devsAboutToBeRemoved()/devsRemoved() and devsAboutToBeInserted()/devsInserted() once per contiguous range of
+ *   removed/inserted devices and devStatusChanged() for devices whose configuration has been altered.
+ * - The index is only rebuilt once after all removals and insertions; see updateDirs().
+ * \returns Returns whether devices have been inserted or altered.
+ */
+bool SyncthingConnection::updateDevs(const QJsonArray &devs)
+{
+    // remove devices which are not present anymore (starting from the back so rows of preceding devices are retained)
+    auto newIds = std::unordered_set<QString>();
+    newIds.reserve(static_cast<std::size_t>(devs.size()));
+    for (const auto &devVal : devs) {
+        newIds.emplace(devVal.toObject().value(QLatin1String("deviceID")).toString());
+    }
+    const auto isRemoved = [this, &newIds](int row) { return newIds.find(m_devs[static_cast<std::size_t>(row)].id) == newIds.end(); };
+    auto reindex = false;
+    for (auto last = static_cast<int>(m_devs.size()) - 1; last >= 0; --last) {
+        if (!isRemoved(last)) {
+            continue;
+        }
+        auto first = last;
+        for (; first > 0 && isRemoved(first - 1); --first)
+            ;
+        emit devsAboutToBeRemoved(first, last);
+        m_devs.erase(m_devs.begin() + first, m_devs.begin() + last + 1);
+        emit devsRemoved(first, last);
+        last = first;
+        reindex = true;
+    }
+
+    // update existing devices and insert new ones (collecting contiguous new devices to insert them at once)
+    auto devsChanged = false;
+    auto alteredRows = std::vector<int>();
+    auto newDevs = std::vector<SyncthingDev>();
+    auto row = 0;
+    const auto insertNewDevs = [this, &newDevs, &row, &reindex, &devsChanged] {
+        if (newDevs.empty()) {
+            return;
+        }
+        const auto last = row + static_cast<int>(newDevs.size()) - 1;
+        emit devsAboutToBeInserted(row, last);
+        m_devs.insert(m_devs.begin() + row, std::make_move_iterator(newDevs.begin()), std::make_move_iterator(newDevs.end()));
+        emit devsInserted(row, last);
+        row = last + 1;
+        newDevs.clear();
+        reindex = devsChanged = true;
+    };
+    for (const auto &devVal : devs) {
+        const auto devObj = devVal.toObject();
+        const auto devId = devObj.value(QLatin1String("deviceID")).toString();
+        if (devId.isEmpty()) {
+            continue;
+        }
+        if (const auto index = static_cast<std::size_t>(row); index < m_devs.size() && m_devs[index].id == devId) {
+            insertNewDevs();
+            if (assignDevConfig(m_devs[static_cast<std::size_t>(row)], devObj)) {
+                alteredRows.emplace_back(row);
+                devsChanged = true;
+            }
+            ++row;
+        } else {
+            assignDevConfig(newDevs.emplace_back(devId), devObj);
+        }
+    }
+    insertNewDevs();
+    if (reindex) {
+        indexDevs();
+    }
+    for (const auto alteredRow : alteredRows) {
+        emitDevStatusChanged(m_devs[static_cast<std::size_t>(alteredRow)], alteredRow);
+    }
+    return devsChanged;
+}
+
+/*!
+ * \brief Returns whether directories and devices present in m_dirs and m_devs appear in the same relative order
+ *        within \a newConfig so they can be updated in place via updateDirsAndDevs().
+ * \remarks Also returns false if an ID is present more than once as in-place updates would not be able to handle this.
+ */
+bool SyncthingConnection::isDirAndDevOrderRetained(const QJsonObject &newConfig) const
+{
+    const auto isOrderRetained = [](const SyncthingIdTable &index, std::size_t itemCount, const QJsonArray &newItems, QLatin1String idKey) {
+        if (index.rowCount() != itemCount) {
+            return false;
+        }
+        auto newIds = std::unordered_set<QString>();
+        newIds.reserve(static_cast<std::size_t>(newItems.size()));
+        auto previousRow = -1;
+        for (const auto &newItem : newItems) {
+            auto id = newItem.toObject().value(idKey).toString();
+            if (id.isEmpty()) {
+                continue;
+            }
+            if (const auto row = index.row(index.handle(id)); row != SyncthingIdTable::noRow) {
+                if (row <= previousRow) {
+                    return false;
+                }
+                previousRow = row;
+            }
+            if (!newIds.emplace(std::move(id)).second) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return isOrderRetained(m_devIds, m_devs.size(), newConfig.value(QLatin1String("devices")).toArray(), QLatin1String("deviceID"))
+        && isOrderRetained(m_dirIds, m_dirs.size(), newConfig.value(QLatin1String("folders")).toArray(), QLatin1String("id"));
+}
+
+/*!
+ * \brief Assigns the configuration from the specified \a dirObj to \a dirInfo.
+ * \returns Returns whether \a dirInfo has been altered.
+ */
+bool SyncthingConnection::assignDirConfig(SyncthingDir &dirInfo, const QJsonObject &dirObj)
+{
+    auto changed = false;
+    const auto assign = [&changed](auto &member, auto &&value) {
+        if (member != value) {
+            member = std::forward<decltype(value)>(value);
+            changed = true;
+        }
+    };
+
+    auto deviceIds = QStringList(), deviceNames = QStringList();
+    int dummy;
+    for (const QJsonValueRef devObj : dirObj.value(QLatin1String("devices")).toArray()) {
+        const QString devId = devObj.toObject().value(QLatin1String("deviceID")).toString();
+        if (devId.isEmpty() || devId == m_myId) {
+            continue;
+        }
+        deviceIds << m_devIds.interned(devId);
+        if (const SyncthingDev *const dev = findDevInfo(devId, dummy)) {
+            deviceNames << dev->name;
+        }
+    }
+    const auto previousDirType = dirInfo.dirType;
+    dirInfo.assignDirType(dirObj.value(QLatin1String("type")).toString());
+    changed = dirInfo.dirType != previousDirType;
+    assign(dirInfo.label, dirObj.value(QLatin1String("label")).toString());
+    assign(dirInfo.path, dirObj.value(QLatin1String("path")).toString());
+    assign(dirInfo.deviceIds, std::move(deviceIds));
+    assign(dirInfo.deviceNames, std::move(deviceNames));
+    assign(dirInfo.rescanInterval, dirObj.value(QLatin1String("rescanIntervalS")).toInt(-1));
+    assign(dirInfo.ignorePermissions, dirObj.value(QLatin1String("ignorePerms")).toBool(false));
+    assign(dirInfo.ignoreDelete, dirObj.value(QLatin1String("ignoreDelete")).toBool(false));
+    assign(dirInfo.autoNormalize, dirObj.value(QLatin1String("autoNormalize")).toBool(false));
+    assign(dirInfo.minDiskFreePercentage, dirObj.value(QLatin1String("minDiskFreePct")).toInt(-1));
+    assign(dirInfo.paused, dirObj.value(QLatin1String("paused")).toBool(dirInfo.paused));
+    assign(dirInfo.fileSystemWatcherEnabled, dirObj.value(QLatin1String("fsWatcherEnabled")).toBool(false));
+    assign(dirInfo.fileSystemWatcherDelay, dirObj.value(QLatin1String("fsWatcherDelayS")).toDouble(0.0));
+    return changed;
+}
+
+/*!
+ * \brief Assigns the configuration from the specified \a devObj to \a devInfo.
+ * \returns Returns whether \a devInfo has been altered.
+ */
+bool SyncthingConnection::assignDevConfig(SyncthingDev &devInfo, const QJsonObject &devObj)
+{
+    auto changed = false;
+    const auto assign = [&changed](auto &member, auto &&value) {
+        if (member != value) {
+            member = std::forward<decltype(value)>(value);
+            changed = true;
+        }
+    };
+
+    assign(devInfo.name, devObj.value(QLatin1String("name")).toString());
+    assign(devInfo.addresses, things(devObj.value(QLatin1String("addresses")).toArray(), [](const QJsonValue &value) { return value.toString(); }));
+    assign(devInfo.compression, devObj.value(QLatin1String("compression")).toString());
+    assign(devInfo.certName, devObj.value(QLatin1String("certName")).toString());
+    assign(devInfo.introducer, devObj.value(QLatin1String("introducer")).toBool(false));
+    if (devInfo.id == m_myId) {
+        assign(devInfo.status, SyncthingDevStatus::OwnDevice);
+        assign(devInfo.paused, false);
+    } else {
+        assign(devInfo.paused, devObj.value(QLatin1String("paused")).toBool(devInfo.paused));
+    }
+    return changed;
 }
 
 // status of Syncthing (own ID, startup time)
@@ -664,7 +1200,7 @@ void SyncthingConnection::readStatus()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const auto replyDoc(QJsonDocument::fromJson(response, &jsonError));
+        const auto replyDoc(parseJsonReply(reply, response, jsonError));
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse Syncthing status: "), jsonError, reply, response);
             handleFatalConnectionError();
@@ -672,11 +1208,20 @@ void SyncthingConnection::readStatus()
         }
 
         const auto replyObj = replyDoc.object();
-        emitMyIdChanged(replyObj.value(QLatin1String("myID")).toString());
-        m_startTime = parseTimeStamp(replyObj.value(QLatin1String("startTime")), QStringLiteral("start time"));
+        const auto myId = replyObj.value(QLatin1String("myID")).toString();
+        const auto startTime = parseTimeStamp(replyObj.value(QLatin1String("startTime")), QStringLiteral("start time"));
+        const auto sameDevice = myId == m_myId, sameInstance = sameDevice && startTime == m_startTime;
+        emitMyIdChanged(myId);
+        m_startTime = startTime;
         m_hasStatus = true;
 
-        if (m_keepPolling) {
+        if (m_resumeState == ResumeState::CheckingStatus) {
+            if (m_keepPolling) {
+                continueResuming(sameDevice, sameInstance);
+            } else {
+                m_resumeState = ResumeState::None;
+            }
+        } else if (m_keepPolling) {
             concludeReadingConfigAndStatus();
         }
         break;
@@ -729,7 +1274,7 @@ void SyncthingConnection::readConnections()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse connections: "), jsonError, reply, response);
             return;
@@ -786,7 +1331,7 @@ void SyncthingConnection::readConnections()
             dev.connectionAddress = connectionObj.value(QLatin1String("address")).toString();
             dev.connectionType = connectionObj.value(QLatin1String("type")).toString();
             dev.clientVersion = connectionObj.value(QLatin1String("clientVersion")).toString();
-            emit devStatusChanged(dev, index);
+            emitDevStatusChanged(dev, index);
             ++index;
         }
 
@@ -795,9 +1340,7 @@ void SyncthingConnection::readConnections()
         // since there seems no event for this data, keep polling
         if (m_keepPolling) {
             concludeConnection();
-            if (m_trafficPollTimer.interval()) {
-                m_trafficPollTimer.start();
-            }
+            startPollTimer(m_trafficPollTimer, m_trafficPollInterval);
         }
 
         break;
@@ -842,7 +1385,7 @@ void SyncthingConnection::readErrors()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse errors: "), jsonError, reply, response);
             return;
@@ -862,9 +1405,7 @@ void SyncthingConnection::readErrors()
         // since there seems no event for this data, keep polling
         if (m_keepPolling) {
             concludeConnection();
-            if (m_errorsPollTimer.interval()) {
-                m_errorsPollTimer.start();
-            }
+            startPollTimer(m_errorsPollTimer, m_errorsPollInterval);
         }
         break;
     }
@@ -901,7 +1442,7 @@ void SyncthingConnection::readDirStatistics()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse directory statistics: "), jsonError, reply, response);
             return;
@@ -937,7 +1478,7 @@ void SyncthingConnection::readDirStatistics()
                 }
             }
             if (dirModified) {
-                emit dirStatusChanged(dirInfo, index);
+                emitDirStatusChanged(dirInfo, index);
             }
             ++index;
         }
@@ -960,12 +1501,24 @@ void SyncthingConnection::readDirStatistics()
  */
 void SyncthingConnection::requestDirStatus(const QString &dirId)
 {
-    QUrlQuery query;
-    query.addQueryItem(QStringLiteral("folder"), dirId);
-    auto *const reply = requestData(QStringLiteral("db/status"), query);
-    reply->setProperty("dirId", dirId);
-    m_otherReplies << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, &SyncthingConnection::readDirStatus, Qt::QueuedConnection);
+    // prefer dirs which are known to be busy or out-of-sync because their status is most relevant
+    auto priority = RequestPriority::Normal;
+    int index;
+    if (const auto *const dirInfo = findDirInfo(dirId, index)) {
+        switch (dirInfo->status) {
+        case SyncthingDirStatus::OutOfSync:
+        case SyncthingDirStatus::Synchronizing:
+        case SyncthingDirStatus::Scanning:
+            priority = RequestPriority::High;
+            break;
+        default:
+            if (dirInfo->pullErrorCount) {
+                priority = RequestPriority::High;
+            }
+        }
+    }
+    scheduleRequest(priority,
+        ScheduledRequest{ m_dirIds.intern(dirId), SyncthingIdTable::invalidHandle, m_requestClock.elapsed() });
 }
 
 /*!
@@ -982,8 +1535,9 @@ void SyncthingConnection::readDirStatus()
     case QNetworkReply::NoError: {
         // determine relevant dir
         int index;
-        const QString dirId(reply->property("dirId").toString());
-        SyncthingDir *const dir = findDirInfo(dirId, index);
+        const auto dirHandle = reply->property("dirHandle").value<SyncthingIdTable::Handle>();
+        const auto dirId = m_dirIds.id(dirHandle);
+        SyncthingDir *const dir = findDirInfo(dirHandle, index);
         if (!dir) {
             // discard status for unknown dirs
             return;
@@ -991,7 +1545,7 @@ void SyncthingConnection::readDirStatus()
 
         // parse JSON
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse status for directory %1: ").arg(dirId), jsonError, reply, response);
             return;
@@ -1053,7 +1607,7 @@ void SyncthingConnection::readDirPullErrors()
     case QNetworkReply::NoError: {
         // parse JSON
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse pull errors for directory %1: ").arg(dirId), jsonError, reply, response);
             return;
@@ -1074,28 +1628,10 @@ void SyncthingConnection::readDirPullErrors()
  */
 void SyncthingConnection::requestCompletion(const QString &devId, const QString &dirId)
 {
-    QUrlQuery query;
-    query.addQueryItem(QStringLiteral("device"), devId);
-    query.addQueryItem(QStringLiteral("folder"), dirId);
-    auto *const reply = requestData(QStringLiteral("db/completion"), query);
-    reply->setProperty("devId", devId);
-    reply->setProperty("dirId", dirId);
-    m_otherReplies << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, &SyncthingConnection::readCompletion, Qt::QueuedConnection);
+    scheduleRequest(RequestPriority::Low,
+        ScheduledRequest{ m_dirIds.intern(dirId), m_devIds.intern(devId), m_requestClock.elapsed() });
 }
 
-/// \cond
-static void ensureCompletionNotConsideredRequested(const QString &devId, SyncthingDev *devInfo, const QString &dirId, SyncthingDir *dirInfo)
-{
-    if (devInfo) {
-        devInfo->completionByDir[dirId].requested = false;
-    }
-    if (dirInfo) {
-        dirInfo->completionByDevice[devId].requested = false;
-    }
-}
-/// \endcond
-
 /*!
  * \brief Reads data from requestCompletion().
  */
@@ -1106,24 +1642,25 @@ void SyncthingConnection::readCompletion()
     const auto *const sender = cancelled ? static_cast<QNetworkReply *>(this->sender()) : reply;
 
     // determine relevant dev/dir
-    const auto devId = sender->property("devId").toString();
-    const auto dirId = sender->property("dirId").toString();
+    const auto devHandle = sender->property("devHandle").value<SyncthingIdTable::Handle>();
+    const auto dirHandle = sender->property("dirHandle").value<SyncthingIdTable::Handle>();
+    const auto devId = m_devIds.id(devHandle), dirId = m_dirIds.id(dirHandle);
     int devIndex, dirIndex;
-    auto *const devInfo = findDevInfo(devId, devIndex);
-    auto *const dirInfo = findDirInfo(dirId, dirIndex);
+    auto *const devInfo = findDevInfo(devHandle, devIndex);
+    auto *const dirInfo = findDirInfo(dirHandle, dirIndex);
     if (!devInfo && !dirInfo) {
         return;
     }
 
     if (cancelled) {
-        ensureCompletionNotConsideredRequested(devId, devInfo, dirId, dirInfo);
+        m_completion.setRequested(dirHandle, devHandle, false);
         return;
     }
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         // parse JSON
         QJsonParseError jsonError;
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const auto replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error == QJsonParseError::NoError) {
             // update the relevant completion info
             readRemoteFolderCompletion(DateTime::now(), replyDoc.object(), devId, devInfo, devIndex, dirId, dirInfo, dirIndex);
@@ -1148,7 +1685,117 @@ void SyncthingConnection::readCompletion()
     default:
         emitError(tr("Unable to request completion for device/directory %1/%2: ").arg(devId, dirId), SyncthingErrorCategory::SpecificRequest, reply);
     }
-    ensureCompletionNotConsideredRequested(devId, devInfo, dirId, dirInfo);
+    m_completion.setRequested(dirHandle, devHandle, false);
+}
+
+// request scheduling
+
+/*!
+ * \brief Sends the specified \a request right away or queues it if maxConcurrentRequests() has been reached.
+ * \remarks Queued requests are sent in the order of their \a priority when previously sent requests have been concluded.
+ */
+void SyncthingConnection::scheduleRequest(RequestPriority priority, ScheduledRequest &&request)
+{
+    if (m_maxConcurrentRequests <= 0 || m_requestQueueStats.inFlight < static_cast<std::size_t>(m_maxConcurrentRequests)) {
+        sendScheduledRequest(request);
+        return;
+    }
+    m_requestQueue[static_cast<std::size_t>(priority)].emplace_back(std::move(request));
+    if (++m_requestQueueStats.queued > m_requestQueueStats.maxQueued) {
+        m_requestQueueStats.maxQueued = m_requestQueueStats.queued;
+    }
+}
+
+/*!
+ * \brief Sends the specified scheduled \a request.
+ */
+void SyncthingConnection::sendScheduledRequest(const ScheduledRequest &request)
+{
+    const auto sentAt = m_requestClock.elapsed();
+    const auto isCompletionRequest = request.devHandle != SyncthingIdTable::invalidHandle;
+    auto query = QUrlQuery();
+    if (isCompletionRequest) {
+        query.addQueryItem(QStringLiteral("device"), m_devIds.id(request.devHandle));
+    }
+    query.addQueryItem(QStringLiteral("folder"), m_dirIds.id(request.dirHandle));
+    auto *const reply = requestData(isCompletionRequest ? QStringLiteral("db/completion") : QStringLiteral("db/status"), query);
+    if (isCompletionRequest) {
+        reply->setProperty("devHandle", request.devHandle);
+    }
+    reply->setProperty("dirHandle", request.dirHandle);
+    reply->setProperty("sentAt", sentAt);
+    m_otherReplies << reply;
+    m_requestQueueStats.totalWaitTime += sentAt - request.queuedAt;
+    ++m_requestQueueStats.inFlight;
+    QObject::connect(reply, &QNetworkReply::finished, this,
+        isCompletionRequest ? &SyncthingConnection::readCompletion : &SyncthingConnection::readDirStatus, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Updates metrics for the specified scheduled \a reply and sends the next queued requests.
+ * \remarks Invoked by prepareReply() as soon as a scheduled request has been concluded (successfully or not).
+ */
+void SyncthingConnection::handleScheduledRequestFinished(QNetworkReply *reply)
+{
+    const auto latency = m_requestClock.elapsed() - reply->property("sentAt").toLongLong();
+    m_requestQueueStats.totalLatency += latency;
+    if (latency > m_requestQueueStats.maxLatency) {
+        m_requestQueueStats.maxLatency = latency;
+    }
+    ++m_requestQueueStats.completed;
+    if (m_requestQueueStats.inFlight) {
+        --m_requestQueueStats.inFlight;
+    }
+    sendQueuedRequests();
+}
+
+/*!
+ * \brief Sends queued requests in the order of their priority as long as maxConcurrentRequests() is not reached.
+ */
+void SyncthingConnection::sendQueuedRequests()
+{
+    for (auto &queue : m_requestQueue) {
+        while (!queue.empty()) {
+            if (m_maxConcurrentRequests > 0 && m_requestQueueStats.inFlight >= static_cast<std::size_t>(m_maxConcurrentRequests)) {
+                return;
+            }
+            const auto request = std::move(queue.front());
+            queue.pop_front();
+            --m_requestQueueStats.queued;
+            sendScheduledRequest(request);
+        }
+    }
+}
+
+/*!
+ * \brief Discards all queued requests; invoked by abortAllRequests().
+ * \remarks Ensures completion which has been queued is no longer considered requested.
+ */
+void SyncthingConnection::clearRequestQueue()
+{
+    for (auto &queue : m_requestQueue) {
+        for (const auto &request : queue) {
+            if (request.devHandle == SyncthingIdTable::invalidHandle) {
+                continue;
+            }
+            m_completion.setRequested(request.dirHandle, request.devHandle, false);
+        }
+        queue.clear();
+    }
+    m_requestQueueStats.queued = 0;
+}
+
+/*!
+ * \brief Sets the maximum number of scheduled requests which are sent concurrently.
+ * \remarks
+ * - Affects only requests for the status of directories and for completion as those are sent in large numbers.
+ * - For default value see SyncthingConnectionSettings. A value of 0 indicates that the number is not limited.
+ * - Queued requests are sent immediately if the new value allows it.
+ */
+void SyncthingConnection::setMaxConcurrentRequests(int maxConcurrentRequests)
+{
+    m_maxConcurrentRequests = maxConcurrentRequests;
+    sendQueuedRequests();
 }
 
 /*!
@@ -1176,7 +1823,7 @@ void SyncthingConnection::readDeviceStatistics()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse device statistics: "), jsonError, reply, response);
             return;
@@ -1188,16 +1835,14 @@ void SyncthingConnection::readDeviceStatistics()
             const QJsonObject devObj(replyObj.value(devInfo.id).toObject());
             if (!devObj.isEmpty()) {
                 devInfo.lastSeen = parseTimeStamp(devObj.value(QLatin1String("lastSeen")), QStringLiteral("last seen"), DateTime(), true);
-                emit devStatusChanged(devInfo, index);
+                emitDevStatusChanged(devInfo, index);
             }
             ++index;
         }
         // since there seems no event for this data, keep polling
         if (m_keepPolling) {
             concludeConnection();
-            if (m_devStatsPollTimer.interval()) {
-                m_devStatsPollTimer.start();
-            }
+            startPollTimer(m_devStatsPollTimer, m_devStatsPollInterval);
         }
         break;
     }
@@ -1231,7 +1876,7 @@ void SyncthingConnection::readVersion()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const auto replyDoc(QJsonDocument::fromJson(response, &jsonError));
+        const auto replyDoc(parseJsonReply(reply, response, jsonError));
         if (jsonError.error != QJsonParseError::NoError) {
             emitError(tr("Unable to parse version: "), jsonError, reply, response);
             return;
@@ -1315,7 +1960,7 @@ void SyncthingConnection::readLog()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
+        const QJsonDocument replyDoc = parseJsonReply(reply, response, jsonError);
         if (jsonError.error != QJsonParseError::NoError) {
             emit error(tr("Unable to parse Syncthing log: ") + jsonError.errorString(), SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
             return;
@@ -1430,7 +2075,7 @@ void SyncthingConnection::readDirSummary(DateTime eventTime, const QJsonObject &
 
     dir.completionPercentage = globalStats.bytes ? static_cast<int>((globalStats.bytes - neededStats.bytes) * 100 / globalStats.bytes) : 100;
 
-    emit dirStatusChanged(dir, index);
+    emitDirStatusChanged(dir, index);
     if (neededStats.isNull() && previouslyUpdated && (neededStats != previouslyNeeded || globalStats != previouslyGlobal)) {
         emit dirCompleted(eventTime, dir, index);
     }
@@ -1474,7 +2119,7 @@ void SyncthingConnection::readDevRejected(DateTime eventTime, const QString &dev
 /*!
  * \brief Reads "LocalChangeDetected" and "RemoveChangeDetected" events from requestEvents() and requestDiskEvents().
  */
-void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readChangeEvent(DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     int index;
     auto *const dirInfo(findDirInfo(QLatin1String("folderID"), eventData, &index));
@@ -1483,16 +2128,21 @@ void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eve
     }
 
     SyncthingFileChange change;
-    change.local = eventType.startsWith("Local");
+    change.local = eventType == SyncthingEventType::LocalChangeDetected;
     change.eventTime = eventTime;
     change.action = eventData.value(QLatin1String("action")).toString();
     change.type = eventData.value(QLatin1String("type")).toString();
     change.modifiedBy = eventData.value(QLatin1String("modifiedBy")).toString();
     change.path = eventData.value(QLatin1String("path")).toString();
-    if (m_recordFileChanges) {
-        dirInfo->recentChanges.emplace_back(move(change));
-        emit dirStatusChanged(*dirInfo, index);
-        emit fileChanged(*dirInfo, index, dirInfo->recentChanges.back());
+    if (m_recordFileChanges && m_recentChangesCapacity) {
+        auto &recentChanges = dirInfo->recentChanges;
+        const auto previousMemoryUsage = recentChanges.memoryUsage();
+        recentChanges.setCapacity(m_recentChangesCapacity);
+        const auto &recordedChange = recentChanges.append(std::move(change));
+        m_recentChangesMemoryUsage = m_recentChangesMemoryUsage - previousMemoryUsage + recentChanges.memoryUsage();
+        enforceRecentChangesMemoryBudget(dirInfo);
+        emitDirStatusChanged(*dirInfo, index);
+        emit fileChanged(*dirInfo, index, recordedChange);
     } else {
         emit fileChanged(*dirInfo, index, change);
     }
@@ -1503,13 +2153,21 @@ void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eve
 /*!
  * \brief Requests the Syncthing events (since the last successful call) asynchronously.
  *
- * The signal newEvents() is emitted on success; otherwise error() is emitted.
+ * The signal newEvents() is emitted on success (if connected); otherwise error() is emitted.
  */
 void SyncthingConnection::requestEvents()
 {
     if (m_eventsReply) {
         return;
     }
+    QObject::connect(m_eventsReply = requestData(QStringLiteral("events"), eventsQuery()), &QNetworkReply::finished, this, &SyncthingConnection::readEvents);
+}
+
+/*!
+ * \brief Returns the query for the next request of requestEvents().
+ */
+QUrlQuery SyncthingConnection::eventsQuery() const
+{
     QUrlQuery query;
     if (m_lastEventId) {
         query.addQueryItem(QStringLiteral("since"), QString::number(m_lastEventId));
@@ -1520,7 +2178,13 @@ void SyncthingConnection::requestEvents()
     if (!m_hasEvents) {
         query.addQueryItem(QStringLiteral("timeout"), QStringLiteral("0"));
     }
-    QObject::connect(m_eventsReply = requestData(QStringLiteral("events"), query), &QNetworkReply::finished, this, &SyncthingConnection::readEvents);
+    // request only events which are actually handled
+    // note: The filter is also used when resuming because event IDs are only consecutive within the sequence of the same filter
+    //       and m_lastEventId originates from that sequence (a changed filter resets m_lastEventId, see updateEventFilter()).
+    if (!m_eventFilter.isEmpty()) {
+        query.addQueryItem(QStringLiteral("events"), m_eventFilter);
+    }
+    return query;
 }
 
 /*!
@@ -1536,21 +2200,18 @@ void SyncthingConnection::readEvents()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const QJsonDocument replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
+        const auto sinceId = m_lastEventId;
+        auto firstId = 0;
+        if (!readEventsFromResponse(response, m_lastEventId, true, "Syncthing events", jsonError, reply, &firstId)) {
             emitError(tr("Unable to parse Syncthing events: "), jsonError, reply, response);
             handleFatalConnectionError();
             return;
         }
-
         m_hasEvents = true;
-        const auto replyArray(replyDoc.array());
-        emit newEvents(replyArray);
-        readEventsFromJsonArray(replyArray, m_lastEventId);
 
-        if (!replyArray.isEmpty() && (loggingFlags() & SyncthingConnectionLoggingFlags::Events)) {
-            const auto log = replyDoc.toJson(QJsonDocument::Indented);
-            cerr << Phrases::Info << "Received " << replyArray.size() << " Syncthing events:" << Phrases::End << log.data() << endl;
+        // re-sync dirs/devs when resuming if events have been missed (Syncthing only buffers a limited number of events)
+        if (haveEventsBeenMissedWhenResuming(sinceId, firstId)) {
+            resyncDirsAndDevs();
         }
         break;
     }
@@ -1574,44 +2235,201 @@ void SyncthingConnection::readEvents()
     }
 }
 
+/*!
+ * \brief Concludes resuming if the first events since resuming have been read and returns whether events have been missed.
+ * \remarks
+ * - Events have been missed if the ID of the first event (\a firstId) is not the successor of the last event ID before
+ *   resuming (\a sinceId). Both IDs are from the same sequence because requestEvents() uses the same filter when resuming.
+ * - If no events have been returned (\a firstId is 0), no events have been missed.
+ * - Returns always false if not resuming.
+ */
+bool SyncthingConnection::haveEventsBeenMissedWhenResuming(int sinceId, int firstId)
+{
+    if (m_resumeState != ResumeState::CheckingEvents) {
+        return false;
+    }
+    m_resumeState = ResumeState::None;
+    return firstId > sinceId + 1;
+}
+
+/*!
+ * \brief Reads the events contained by the specified \a response of requestEvents() or requestDiskEvents().
+ * \remarks
+ * - The response is only split into SyncthingEventRecord objects and only the data of events which are actually
+ *   handled is parsed. A QJsonDocument of the whole response is only created if it is needed because \a emitNewEvents
+ *   is set and newEvents() is connected or because events are supposed to be logged.
+ * - The data of an event is parsed on demand right before the event is read. Malformed event data is reported via
+ *   emitError() and only the affected event is skipped.
+ * - Returns whether \a response could be parsed; otherwise \a jsonError is set accordingly.
+ * - The time spent on parsing is recorded for the endpoint of \a reply if specified.
+ * - The ID of the first event is assigned to \a firstId if specified and \a response contains events with IDs.
+ */
+bool SyncthingConnection::readEventsFromResponse(const QByteArray &response, int &idVariable, bool emitNewEvents, const char *logContext,
+    QJsonParseError &jsonError, QNetworkReply *reply, int *firstId)
+{
+    emitNewEvents = emitNewEvents && isSignalConnected(QMetaMethod::fromSignal(&SyncthingConnection::newEvents));
+    const auto logEvents = static_cast<bool>(loggingFlags() & SyncthingConnectionLoggingFlags::Events);
+    if (emitNewEvents || logEvents) {
+        const auto replyDoc = parseJsonReply(reply, response, jsonError);
+        if (jsonError.error != QJsonParseError::NoError) {
+            return false;
+        }
+        const auto replyArray = replyDoc.array();
+        if (firstId && !replyArray.isEmpty()) {
+            *firstId = replyArray.first().toObject().value(QLatin1String("id")).toInt(*firstId);
+        }
+        if (emitNewEvents) {
+            emit newEvents(replyArray);
+        }
+        readEventsFromJsonArray(replyArray, idVariable);
+        if (logEvents && !replyArray.isEmpty()) {
+            const auto log = replyDoc.toJson(QJsonDocument::Indented);
+            cerr << Phrases::Info << "Received " << replyArray.size() << ' ' << logContext << ':' << Phrases::End << log.data() << endl;
+        }
+        return true;
+    }
+
+    auto *const stats = endpointStatistics(reply);
+    auto parseStartedAt = stats ? monotonicMicroseconds() : 0;
+    const auto records = scanSyncthingEvents(std::string_view(response.data(), static_cast<std::size_t>(response.size())), jsonError);
+    auto parseTime = stats ? monotonicMicroseconds() - parseStartedAt : 0;
+    if (jsonError.error != QJsonParseError::NoError) {
+        return false;
+    }
+    if (firstId && !records.empty() && records.front().hasId) {
+        *firstId = records.front().id;
+    }
+    m_batchingStatusChanges = true;
+    for (const auto &record : records) {
+        if (record.hasId) {
+            idVariable = record.id;
+        }
+        if (record.type == SyncthingEventType::Unknown) {
+            continue;
+        }
+
+        // parse the data of the event on demand so only one small object exists at a time
+        if (stats) {
+            parseStartedAt = monotonicMicroseconds();
+        }
+        auto eventData = QJsonObject();
+        if (!record.data.empty()) {
+            auto dataError = QJsonParseError();
+            const auto rawData = QByteArray::fromRawData(record.data.data(), static_cast<int>(record.data.size()));
+            eventData = QJsonDocument::fromJson(rawData, &dataError).object();
+            if (dataError.error != QJsonParseError::NoError) {
+                // report the offset within the response and skip only the affected event
+                dataError.offset += static_cast<int>(record.data.data() - response.data());
+                emitError(tr("Unable to parse data of Syncthing event: "), dataError, reply, response);
+                continue;
+            }
+        }
+        if (stats) {
+            parseTime += monotonicMicroseconds() - parseStartedAt;
+        }
+        const auto eventTime = parseTimeStamp(
+            QJsonValue(QString::fromLatin1(record.time.data(), static_cast<int>(record.time.size()))), QStringLiteral("event time"));
+        readEvent(record.type, eventTime, eventData);
+    }
+    if (stats) {
+        stats->parseTime.record(parseTime);
+    }
+    flushStatusChanges();
+    emitDirStatisticsChanged();
+    return true;
+}
+
 /*!
  * \brief Reads results of requestEvents().
  */
 void SyncthingConnection::readEventsFromJsonArray(const QJsonArray &events, int &idVariable)
 {
+    m_batchingStatusChanges = true;
     for (const auto &eventVal : events) {
         const auto event = eventVal.toObject();
-        const auto eventTime = parseTimeStamp(event.value(QLatin1String("time")), QStringLiteral("event time"));
-        const auto eventType = event.value(QLatin1String("type")).toString();
-        const auto eventData = event.value(QLatin1String("data")).toObject();
-
         idVariable = event.value(QLatin1String("id")).toInt(idVariable);
 
-        if (eventType == QLatin1String("Starting")) {
-            readStartingEvent(eventData);
-        } else if (eventType == QLatin1String("StateChanged")) {
-            readStatusChangedEvent(eventTime, eventData);
-        } else if (eventType == QLatin1String("DownloadProgress")) {
-            readDownloadProgressEvent(eventTime, eventData);
-        } else if (eventType.startsWith(QLatin1String("Folder"))) {
-            readDirEvent(eventTime, eventType, eventData);
-        } else if (eventType.startsWith(QLatin1String("Device"))) {
-            readDeviceEvent(eventTime, eventType, eventData);
-        } else if (eventType == QLatin1String("ItemStarted")) {
-            readItemStarted(eventTime, eventData);
-        } else if (eventType == QLatin1String("ItemFinished")) {
-            readItemFinished(eventTime, eventData);
-        } else if (eventType == QLatin1String("RemoteIndexUpdated")) {
-            readRemoteIndexUpdated(eventTime, eventData);
-        } else if (eventType == QLatin1String("ConfigSaved")) {
-            requestConfig(); // just consider current config as invalidated
-        } else if (eventType.endsWith(QLatin1String("ChangeDetected"))) {
-            readChangeEvent(eventTime, eventType, eventData);
+        // skip event types which are not handled anyways before doing any further parsing
+        const auto eventType = syncthingEventType(event.value(QLatin1String("type")).toString());
+        if (eventType == SyncthingEventType::Unknown) {
+            continue;
         }
+        const auto eventTime = parseTimeStamp(event.value(QLatin1String("time")), QStringLiteral("event time"));
+        readEvent(eventType, eventTime, event.value(QLatin1String("data")).toObject());
     }
+    flushStatusChanges();
     emitDirStatisticsChanged();
 }
 
+/*!
+ * \brief Dispatches a single event of the specified \a eventType to the corresponding handler.
+ */
+void SyncthingConnection::readEvent(SyncthingEventType eventType, DateTime eventTime, const QJsonObject &eventData)
+{
+    // poll at the configured intervals again when an event indicates activity
+    switch (eventType) {
+    case SyncthingEventType::DownloadProgress:
+    case SyncthingEventType::FolderScanProgress:
+    case SyncthingEventType::DeviceConnected:
+    case SyncthingEventType::DeviceDisconnected:
+    case SyncthingEventType::ItemStarted:
+    case SyncthingEventType::ItemFinished:
+    case SyncthingEventType::RemoteIndexUpdated:
+    case SyncthingEventType::LocalChangeDetected:
+    case SyncthingEventType::RemoteChangeDetected:
+        handlePollingActivity();
+        break;
+    default:;
+    }
+
+    switch (eventType) {
+    case SyncthingEventType::Starting:
+        readStartingEvent(eventData);
+        break;
+    case SyncthingEventType::StateChanged:
+        readStatusChangedEvent(eventTime, eventData);
+        break;
+    case SyncthingEventType::DownloadProgress:
+        readDownloadProgressEvent(eventTime, eventData);
+        break;
+    case SyncthingEventType::FolderCompletion:
+    case SyncthingEventType::FolderErrors:
+    case SyncthingEventType::FolderPaused:
+    case SyncthingEventType::FolderRejected:
+    case SyncthingEventType::FolderResumed:
+    case SyncthingEventType::FolderScanProgress:
+    case SyncthingEventType::FolderSummary:
+        readDirEvent(eventTime, eventType, eventData);
+        break;
+    case SyncthingEventType::DeviceConnected:
+    case SyncthingEventType::DeviceDisconnected:
+    case SyncthingEventType::DeviceDiscovered:
+    case SyncthingEventType::DevicePaused:
+    case SyncthingEventType::DeviceRejected:
+    case SyncthingEventType::DeviceResumed:
+        readDeviceEvent(eventTime, eventType, eventData);
+        break;
+    case SyncthingEventType::ItemStarted:
+        readItemStarted(eventTime, eventData);
+        break;
+    case SyncthingEventType::ItemFinished:
+        readItemFinished(eventTime, eventData);
+        break;
+    case SyncthingEventType::RemoteIndexUpdated:
+        readRemoteIndexUpdated(eventTime, eventData);
+        break;
+    case SyncthingEventType::ConfigSaved:
+        requestConfig(); // just consider current config as invalidated
+        break;
+    case SyncthingEventType::LocalChangeDetected:
+    case SyncthingEventType::RemoteChangeDetected:
+        readChangeEvent(eventTime, eventType, eventData);
+        break;
+    case SyncthingEventType::Unknown:
+        break;
+    }
+}
+
 /*!
  * \brief Reads results of requestEvents().
  */
@@ -1641,8 +2459,13 @@ void SyncthingConnection::readStatusChangedEvent(DateTime eventTime, const QJson
     // add a new directory if the dir is not present yet
     const bool dirAlreadyPresent = dirInfo;
     if (!dirAlreadyPresent) {
-        m_dirs.emplace_back(dir);
+        index = static_cast<int>(m_dirs.size());
+        emit dirsAboutToBeInserted(index, index);
+        const auto dirHandle = m_dirIds.intern(dir);
+        m_dirIds.setRow(dirHandle, index);
+        m_dirs.emplace_back(m_dirIds.id(dirHandle));
         dirInfo = &m_dirs.back();
+        emit dirsInserted(index, index);
     }
 
     // assign new status
@@ -1657,36 +2480,69 @@ void SyncthingConnection::readStatusChangedEvent(DateTime eventTime, const QJson
     if (dirAlreadyPresent) {
         // emit status changed when dir already present
         if (statusChanged) {
-            emit dirStatusChanged(*dirInfo, index);
+            emitDirStatusChanged(*dirInfo, index);
         }
     } else {
         // request config for complete meta data of new directory
+        m_dirStatusTable.update(*dirInfo, static_cast<std::size_t>(index));
         requestConfig();
     }
 }
 
 /*!
  * \brief Reads results of requestEvents().
+ * \remarks
+ * - Directories which are neither mentioned by the event nor have been downloading before are skipped.
+ * - Items are updated in place; only items which appeared since the last event are constructed. Items vanishing implies
+ *   that their download has been finished so they are simply removed.
+ * - The labels of items and directories are only re-formatted if the number of downloaded blocks has changed.
+ * - downloadProgressChanged() is only emitted if anything has changed.
  */
 void SyncthingConnection::readDownloadProgressEvent(DateTime eventTime, const QJsonObject &eventData)
 {
     CPP_UTILITIES_UNUSED(eventTime)
+    auto anyDirChanged = false;
+    auto items = std::vector<SyncthingItemDownloadProgress>();
     for (SyncthingDir &dirInfo : m_dirs) {
-        // disappearing implies that the download has been finished so just wipe old entries
-        dirInfo.downloadingItems.clear();
-        dirInfo.blocksAlreadyDownloaded = dirInfo.blocksToBeDownloaded = 0;
-
-        // read progress of currently downloading items
-        const QJsonObject dirObj(eventData.value(dirInfo.id).toObject());
-        if (!dirObj.isEmpty()) {
-            dirInfo.downloadingItems.reserve(static_cast<size_t>(dirObj.size()));
-            for (auto filePair = dirObj.constBegin(), end = dirObj.constEnd(); filePair != end; ++filePair) {
-                dirInfo.downloadingItems.emplace_back(dirInfo.path, filePair.key(), filePair.value().toObject());
-                const SyncthingItemDownloadProgress &itemProgress = dirInfo.downloadingItems.back();
-                dirInfo.blocksAlreadyDownloaded += itemProgress.blocksAlreadyDownloaded;
-                dirInfo.blocksToBeDownloaded += itemProgress.totalNumberOfBlocks;
+        const auto dirObj = eventData.value(dirInfo.id).toObject();
+        if (dirObj.isEmpty() && dirInfo.downloadingItems.empty() && !dirInfo.downloadLabel.isEmpty()) {
+            continue;
+        }
+
+        // merge progress of currently downloading items with existing items (both are ordered by the relative path)
+        auto changed = static_cast<std::size_t>(dirObj.size()) != dirInfo.downloadingItems.size();
+        auto blocksAlreadyDownloaded = 0, blocksToBeDownloaded = 0;
+        auto existingItem = dirInfo.downloadingItems.begin(), existingEnd = dirInfo.downloadingItems.end();
+        items.clear();
+        items.reserve(static_cast<std::size_t>(dirObj.size()));
+        for (auto filePair = dirObj.constBegin(), end = dirObj.constEnd(); filePair != end; ++filePair) {
+            const auto relativePath = filePair.key();
+            for (; existingItem != existingEnd && existingItem->relativePath < relativePath; ++existingItem) {
+                changed = true;
             }
+            if (existingItem != existingEnd && existingItem->relativePath == relativePath) {
+                auto &itemProgress = items.emplace_back(std::move(*existingItem++));
+                changed = itemProgress.updateValues(filePair.value().toObject()) || changed;
+            } else {
+                items.emplace_back(dirInfo.path, relativePath, filePair.value().toObject());
+                changed = true;
+            }
+            blocksAlreadyDownloaded += items.back().blocksAlreadyDownloaded;
+            blocksToBeDownloaded += items.back().totalNumberOfBlocks;
+        }
+        dirInfo.downloadingItems.swap(items);
+        if (!changed && !dirInfo.downloadLabel.isEmpty()) {
+            continue;
+        }
+        anyDirChanged = true;
+
+        // update the overall progress of the directory
+        if (blocksAlreadyDownloaded == dirInfo.blocksAlreadyDownloaded && blocksToBeDownloaded == dirInfo.blocksToBeDownloaded
+            && !dirInfo.downloadLabel.isEmpty()) {
+            continue;
         }
+        dirInfo.blocksAlreadyDownloaded = blocksAlreadyDownloaded;
+        dirInfo.blocksToBeDownloaded = blocksToBeDownloaded;
         dirInfo.downloadPercentage = (dirInfo.blocksAlreadyDownloaded > 0 && dirInfo.blocksToBeDownloaded > 0)
             ? (static_cast<unsigned int>(dirInfo.blocksAlreadyDownloaded) * 100 / static_cast<unsigned int>(dirInfo.blocksToBeDownloaded))
             : 0;
@@ -1702,13 +2558,15 @@ void SyncthingConnection::readDownloadProgressEvent(DateTime eventTime, const QJ
                                               .data()),
                       QString::number(dirInfo.downloadPercentage));
     }
-    emit downloadProgressChanged();
+    if (anyDirChanged) {
+        emit downloadProgressChanged();
+    }
 }
 
 /*!
  * \brief Reads results of requestEvents().
  */
-void SyncthingConnection::readDirEvent(DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readDirEvent(DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     // read dir ID
     const auto dirId([&eventData] {
@@ -1720,14 +2578,14 @@ void SyncthingConnection::readDirEvent(DateTime eventTime, const QString &eventT
     }());
     if (dirId.isEmpty()) {
         // handle events which don't necessarily require a corresponding dir info
-        if (eventType == QLatin1String("FolderCompletion")) {
+        if (eventType == SyncthingEventType::FolderCompletion) {
             readFolderCompletion(eventTime, eventData, dirId, nullptr, -1);
         }
         return;
     }
 
     // handle "FolderRejected"-event which is a bit special because here the dir ID is supposed to be unknown
-    if (eventType == QLatin1String("FolderRejected")) {
+    if (eventType == SyncthingEventType::FolderRejected) {
         readDirRejected(eventTime, dirId, eventData);
         return;
     }
@@ -1740,13 +2598,19 @@ void SyncthingConnection::readDirEvent(DateTime eventTime, const QString &eventT
     }
 
     // distinguish specific events
-    if (eventType == QLatin1String("FolderErrors")) {
+    switch (eventType) {
+    case SyncthingEventType::FolderErrors:
         readFolderErrors(eventTime, eventData, *dirInfo, index);
-    } else if (eventType == QLatin1String("FolderSummary")) {
+        break;
+    case SyncthingEventType::FolderSummary:
         readDirSummary(eventTime, eventData.value(QLatin1String("summary")).toObject(), *dirInfo, index);
-    } else if (eventType == QLatin1String("FolderCompletion") && dirInfo->lastStatisticsUpdate < eventTime) {
-        readFolderCompletion(eventTime, eventData, dirId, dirInfo, index);
-    } else if (eventType == QLatin1String("FolderScanProgress")) {
+        break;
+    case SyncthingEventType::FolderCompletion:
+        if (dirInfo->lastStatisticsUpdate < eventTime) {
+            readFolderCompletion(eventTime, eventData, dirId, dirInfo, index);
+        }
+        break;
+    case SyncthingEventType::FolderScanProgress: {
         const double current = eventData.value(QLatin1String("current")).toDouble(0);
         const double total = eventData.value(QLatin1String("total")).toDouble(0);
         const double rate = eventData.value(QLatin1String("rate")).toDouble(0);
@@ -1754,25 +2618,30 @@ void SyncthingConnection::readDirEvent(DateTime eventTime, const QString &eventT
             dirInfo->scanningPercentage = static_cast<int>(current * 100 / total);
             dirInfo->scanningRate = rate;
             dirInfo->assignStatus(SyncthingDirStatus::Scanning, eventTime); // ensure state is scanning
-            emit dirStatusChanged(*dirInfo, index);
+            emitDirStatusChanged(*dirInfo, index);
         }
-    } else if (eventType == QLatin1String("FolderPaused")) {
+        break;
+    }
+    case SyncthingEventType::FolderPaused:
         if (!dirInfo->paused) {
             dirInfo->paused = true;
-            emit dirStatusChanged(*dirInfo, index);
+            emitDirStatusChanged(*dirInfo, index);
         }
-    } else if (eventType == QLatin1String("FolderResumed")) {
+        break;
+    case SyncthingEventType::FolderResumed:
         if (dirInfo->paused) {
             dirInfo->paused = false;
-            emit dirStatusChanged(*dirInfo, index);
+            emitDirStatusChanged(*dirInfo, index);
         }
+        break;
+    default:;
     }
 }
 
 /*!
  * \brief Reads results of requestEvents().
  */
-void SyncthingConnection::readDeviceEvent(DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readDeviceEvent(DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     // ignore device events happened before the last connections update
     if (eventTime.isNull() && m_lastConnectionsUpdate.isNull() && eventTime < m_lastConnectionsUpdate) {
@@ -1784,7 +2653,7 @@ void SyncthingConnection::readDeviceEvent(DateTime eventTime, const QString &eve
     }
 
     // handle "FolderRejected"-event which is a bit special because here the dir ID is supposed to be unknown
-    if (eventType == QLatin1String("DeviceRejected")) {
+    if (eventType == SyncthingEventType::DeviceRejected) {
         readDevRejected(eventTime, dev, eventData);
         return;
     }
@@ -1799,24 +2668,28 @@ void SyncthingConnection::readDeviceEvent(DateTime eventTime, const QString &eve
     // distinguish specific events
     SyncthingDevStatus status = devInfo->status;
     bool paused = devInfo->paused;
-    if (eventType == QLatin1String("DeviceConnected")) {
+    switch (eventType) {
+    case SyncthingEventType::DeviceConnected:
         devInfo->setConnectedStateAccordingToCompletion();
-    } else if (eventType == QLatin1String("DeviceDisconnected")) {
+        break;
+    case SyncthingEventType::DeviceDisconnected:
         status = SyncthingDevStatus::Disconnected;
-    } else if (eventType == QLatin1String("DevicePaused")) {
+        break;
+    case SyncthingEventType::DevicePaused:
         paused = true;
-    } else if (eventType == QLatin1String("DeviceRejected")) {
-        status = SyncthingDevStatus::Rejected;
-    } else if (eventType == QLatin1String("DeviceResumed")) {
+        break;
+    case SyncthingEventType::DeviceResumed:
         paused = false;
         // FIXME: correct to assume device which has just been resumed is still disconnected?
         status = SyncthingDevStatus::Disconnected;
-    } else if (eventType == QLatin1String("DeviceDiscovered")) {
+        break;
+    case SyncthingEventType::DeviceDiscovered:
         // we know about this device already, set status anyways because it might still be unknown
         if (status == SyncthingDevStatus::Unknown) {
             status = SyncthingDevStatus::Disconnected;
         }
-    } else {
+        break;
+    default:
         return; // can't handle other event types currently
     }
 
@@ -1827,7 +2700,7 @@ void SyncthingConnection::readDeviceEvent(DateTime eventTime, const QString &eve
             devInfo->status = status;
             devInfo->paused = paused;
         }
-        emit devStatusChanged(*devInfo, index);
+        emitDevStatusChanged(*devInfo, index);
     }
 }
 
@@ -1871,7 +2744,7 @@ void SyncthingConnection::readItemFinished(DateTime eventTime, const QJsonObject
         }
 
         // emitNotification will trigger status update, so no need to call setStatus(status())
-        emit dirStatusChanged(*dirInfo, index);
+        emitDirStatusChanged(*dirInfo, index);
         emitNotification(eventTime, error);
         return;
     }
@@ -1886,7 +2759,7 @@ void SyncthingConnection::readItemFinished(DateTime eventTime, const QJsonObject
             m_lastFileName = dirInfo->lastFileName;
             m_lastFileDeleted = dirInfo->lastFileDeleted;
         }
-        emit dirStatusChanged(*dirInfo, index);
+        emitDirStatusChanged(*dirInfo, index);
     }
 }
 
@@ -1924,7 +2797,7 @@ void SyncthingConnection::readFolderErrors(DateTime eventTime, const QJsonObject
         dirInfo.assignStatus(SyncthingDirStatus::OutOfSync, eventTime);
     }
 
-    emit dirStatusChanged(dirInfo, index);
+    emitDirStatusChanged(dirInfo, index);
 }
 
 /*!
@@ -1970,7 +2843,7 @@ void SyncthingConnection::readLocalFolderCompletion(DateTime eventTime, const QJ
     neededStats.deletes = jsonValueToInt(eventData.value(QLatin1String("needItems")), static_cast<double>(neededStats.files));
     dirInfo.lastStatisticsUpdate = eventTime;
     dirInfo.completionPercentage = globalStats.bytes ? static_cast<int>((globalStats.bytes - neededStats.bytes) * 100 / globalStats.bytes) : 100;
-    emit dirStatusChanged(dirInfo, index);
+    emitDirStatusChanged(dirInfo, index);
     if (neededStats.isNull() && previouslyUpdated && (neededStats != previouslyNeeded || globalStats != previouslyGlobal)
         && dirInfo.status != SyncthingDirStatus::WaitingToScan && dirInfo.status != SyncthingDirStatus::Scanning) {
         emit dirCompleted(eventTime, dirInfo, index);
@@ -2003,29 +2876,28 @@ void SyncthingConnection::readRemoteFolderCompletion(DateTime eventTime, const Q
 void SyncthingConnection::readRemoteFolderCompletion(const SyncthingCompletion &completion, const QString &devId, SyncthingDev *devInfo, int devIndex,
     const QString &dirId, SyncthingDir *dirInfo, int dirIndex)
 {
+    // update completion matrix
+    const auto dirHandle = m_dirIds.intern(dirId), devHandle = m_devIds.intern(devId);
+    const auto *const previousCompletion = m_completion.find(dirHandle, devHandle);
+    const auto previouslyUpdated = previousCompletion && !previousCompletion->lastUpdate.isNull();
+    const auto previouslyNeeded = previousCompletion && !previousCompletion->needed.isNull();
+    const auto previousGlobalBytes = previousCompletion ? previousCompletion->globalBytes : 0;
+    m_completion.assign(dirHandle, devHandle, completion);
+
     // update dir info
     if (dirInfo) {
-        auto &previousCompletion = dirInfo->completionByDevice[devId];
-        const auto previouslyUpdated = !previousCompletion.lastUpdate.isNull();
-        const auto previouslyNeeded = !previousCompletion.needed.isNull();
-        const auto previousGlobalBytes = previousCompletion.globalBytes;
-        previousCompletion = completion;
-        emit dirStatusChanged(*dirInfo, dirIndex);
+        emitDirStatusChanged(*dirInfo, dirIndex);
         if (devInfo && completion.needed.isNull() && previouslyUpdated && (previouslyNeeded || previousGlobalBytes != completion.globalBytes)) {
             emit dirCompleted(DateTime::now(), *dirInfo, dirIndex, devInfo);
         }
     }
     // update dev info
     if (devInfo) {
-        auto &previousCompletion = devInfo->completionByDir[dirId];
-        devInfo->overallCompletion -= previousCompletion;
-        devInfo->overallCompletion += completion;
-        devInfo->overallCompletion.recomputePercentage();
-        previousCompletion = completion;
+        devInfo->overallCompletion = m_completion.overallCompletionOfDev(devHandle);
         if (devInfo->isConnected()) {
             devInfo->setConnectedStateAccordingToCompletion();
         }
-        emit devStatusChanged(*devInfo, devIndex);
+        emitDevStatusChanged(*devInfo, devIndex);
     }
 }
 
@@ -2034,8 +2906,8 @@ void SyncthingConnection::readRemoteFolderCompletion(const SyncthingCompletion &
  */
 void SyncthingConnection::readRemoteIndexUpdated(DateTime eventTime, const QJsonObject &eventData)
 {
-    // ignore those events if we're not updating completion automatically
-    if (!m_requestCompletion && !m_keepPolling) {
+    // ignore those events if we're not updating completion automatically (they are not even requested in this case, see updateEventFilter())
+    if (!m_requestCompletion) {
         return;
     }
 
@@ -2060,26 +2932,13 @@ void SyncthingConnection::readRemoteIndexUpdated(DateTime eventTime, const QJson
     }
 
     // request completion again if not already requested and out-of-date
-    // note: Considering the current completion info stored within the dir info and the dev info. That
-    //       should not be required because both should be in sync but theoretically a user of the library
-    //       might meddle with that.
-    auto *const completionFromDirInfo = dirInfo ? &dirInfo->completionByDevice[devId] : nullptr;
-    auto *const completionFromDevInfo = devInfo ? &devInfo->completionByDir[dirId] : nullptr;
-    if ((completionFromDirInfo && completionFromDirInfo->requested) || (completionFromDevInfo && completionFromDevInfo->requested)) {
-        return;
-    }
-    const auto lastUpdate = completionFromDirInfo && completionFromDevInfo
-        ? min(completionFromDirInfo->lastUpdate, completionFromDevInfo->lastUpdate)
-        : (completionFromDirInfo ? completionFromDirInfo->lastUpdate : completionFromDevInfo->lastUpdate);
-    if (lastUpdate >= eventTime) {
-        return;
-    }
-    if (completionFromDirInfo) {
-        completionFromDirInfo->requested = true;
-    }
-    if (completionFromDevInfo) {
-        completionFromDevInfo->requested = true;
+    const auto dirHandle = m_dirIds.intern(dirId), devHandle = m_devIds.intern(devId);
+    if (const auto *const completion = m_completion.find(dirHandle, devHandle)) {
+        if (completion->requested || completion->lastUpdate >= eventTime) {
+            return;
+        }
     }
+    m_completion.setRequested(dirHandle, devHandle, true);
     if (devInfo && dirInfo && !devInfo->paused && !dirInfo->paused) {
         requestCompletion(devId, dirId);
     }
@@ -2119,20 +2978,11 @@ void SyncthingConnection::readDiskEvents()
     switch (reply->error()) {
     case QNetworkReply::NoError: {
         QJsonParseError jsonError;
-        const auto replyDoc(QJsonDocument::fromJson(response, &jsonError));
-        if (jsonError.error != QJsonParseError::NoError) {
+        if (!readEventsFromResponse(response, m_lastDiskEventId, false, "Syncthing disk events", jsonError, reply)) {
             emitError(tr("Unable to parse disk events: "), jsonError, reply, response);
             return;
         }
-
-        const auto replyArray = replyDoc.array();
         m_hasDiskEvents = true;
-        readEventsFromJsonArray(replyArray, m_lastDiskEventId);
-
-        if (!replyArray.isEmpty() && (loggingFlags() & SyncthingConnectionLoggingFlags::Events)) {
-            const auto log = replyDoc.toJson(QJsonDocument::Indented);
-            cerr << Phrases::Info << "Received " << replyArray.size() << " Syncthing disk events:" << Phrases::End << log.data() << endl;
-        }
         break;
     }
     case QNetworkReply::TimeoutError:
@@ -2148,7 +2998,7 @@ void SyncthingConnection::readDiskEvents()
     }
 
     if (m_keepPolling) {
-        requestDiskEvents();
+        requestDiskEventsIfRequired();
         concludeConnection();
     }
 }
@@ -0,0 +1,259 @@
+#include "./syncthingconnection.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+using namespace CppUtilities;
+
+namespace Data {
+
+/// \cond
+constexpr quint32 snapshotMagic = 0x53545353; // "STSS"
+constexpr quint32 snapshotVersion = 2;
+constexpr auto snapshotStreamVersion = QDataStream::Qt_5_6;
+constexpr int snapshotSaveInterval = 5 * 60 * 1000;
+
+static QDataStream &operator<<(QDataStream &out, DateTime dateTime)
+{
+    return out << static_cast<quint64>(dateTime.totalTicks());
+}
+
+static QDataStream &operator>>(QDataStream &in, DateTime &dateTime)
+{
+    auto ticks = quint64();
+    in >> ticks;
+    dateTime = DateTime(ticks);
+    return in;
+}
+
+static QDataStream &operator<<(QDataStream &out, const SyncthingStatistics &stats)
+{
+    return out << stats.bytes << stats.deletes << stats.dirs << stats.files << stats.symlinks;
+}
+
+static QDataStream &operator>>(QDataStream &in, SyncthingStatistics &stats)
+{
+    return in >> stats.bytes >> stats.deletes >> stats.dirs >> stats.files >> stats.symlinks;
+}
+
+static QDataStream &operator<<(QDataStream &out, const SyncthingCompletion &completion)
+{
+    return out << completion.lastUpdate << completion.percentage << completion.globalBytes << completion.needed.bytes << completion.needed.items
+               << completion.needed.deletes;
+}
+
+static QDataStream &operator>>(QDataStream &in, SyncthingCompletion &completion)
+{
+    return in >> completion.lastUpdate >> completion.percentage >> completion.globalBytes >> completion.needed.bytes >> completion.needed.items
+        >> completion.needed.deletes;
+}
+
+using CompletionByDevice = std::vector<std::pair<QString, SyncthingCompletion>>;
+
+static void writeCompletion(
+    QDataStream &out, const SyncthingCompletionMatrix &completion, const SyncthingIdTable &devIds, SyncthingIdTable::Handle dirHandle)
+{
+    const auto &devHandles = completion.devsOf(dirHandle);
+    out << static_cast<quint32>(devHandles.size());
+    for (const auto devHandle : devHandles) {
+        out << devIds.id(devHandle) << *completion.find(dirHandle, devHandle);
+    }
+}
+
+static QDataStream &operator>>(QDataStream &in, CompletionByDevice &completionByDevice)
+{
+    auto size = quint32();
+    in >> size;
+    completionByDevice.clear();
+    for (; size && in.status() == QDataStream::Ok; --size) {
+        auto &[devId, completion] = completionByDevice.emplace_back();
+        in >> devId >> completion;
+    }
+    return in;
+}
+/// \endcond
+
+/*!
+ * \brief Sets the path of the file a snapshot of the directories and devices is persisted to.
+ * \remarks
+ * - The snapshot contains the information needed to populate the models (IDs, labels, paths, statistics and completion)
+ *   but not the (constantly changing) status of directories and devices.
+ * - A snapshot of the current state is saved periodically, when the path is changed and when the connection is
+ *   destroyed. This only happens if up-to-date information has been received from Syncthing.
+ * - If no information has been received from Syncthing so far, the snapshot at the new \a snapshotPath is loaded right
+ *   away. The restored directories and devices are considered stale until the configuration has been received from
+ *   Syncthing; see hasStaleDirsAndDevs().
+ * - When reconnecting, the snapshot is not loaded again. The directories and devices of the previous connection are
+ *   kept in memory as stale directories and devices instead.
+ * - An empty \a snapshotPath disables snapshots.
+ */
+void SyncthingConnection::setSnapshotPath(const QString &snapshotPath)
+{
+    if (m_snapshotPath == snapshotPath) {
+        return;
+    }
+    saveSnapshotIfUpToDate();
+    m_snapshotPath = snapshotPath;
+    if (m_snapshotPath.isEmpty()) {
+        m_snapshotTimer.stop();
+        return;
+    }
+    if (!m_snapshotTimer.isActive()) {
+        m_snapshotTimer.start(snapshotSaveInterval);
+    }
+    if (!m_hasConfig) {
+        loadSnapshot();
+    }
+}
+
+/*!
+ * \brief Saves a snapshot of the current directories and devices to snapshotPath().
+ * \returns Returns whether the snapshot could be written.
+ */
+bool SyncthingConnection::saveSnapshot() const
+{
+    if (m_snapshotPath.isEmpty()) {
+        return false;
+    }
+    const auto dir = QFileInfo(m_snapshotPath).absoluteDir();
+    if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
+        return false;
+    }
+    auto file = QSaveFile(m_snapshotPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    auto out = QDataStream(&file);
+    out.setVersion(snapshotStreamVersion);
+    out << snapshotMagic << snapshotVersion << m_myId;
+    out << static_cast<quint32>(m_devs.size());
+    for (const auto &dev : m_devs) {
+        out << dev.id << dev.name << dev.addresses << dev.compression << dev.certName << dev.lastSeen << dev.introducer << dev.paused;
+    }
+    out << static_cast<quint32>(m_dirs.size());
+    for (const auto &dir : m_dirs) {
+        out << dir.id << dir.label << dir.path << dir.deviceIds << dir.deviceNames << static_cast<qint32>(dir.dirType) << dir.rescanInterval
+            << dir.minDiskFreePercentage << dir.fileSystemWatcherDelay;
+        writeCompletion(out, m_completion, m_devIds, m_dirIds.handle(dir.id));
+        out << dir.completionPercentage << dir.globalStats << dir.localStats << dir.neededStats << dir.lastStatisticsUpdate << dir.lastScanTime
+            << dir.lastFileTime << dir.lastFileName << dir.ignorePermissions << dir.ignoreDelete << dir.ignorePatterns << dir.autoNormalize
+            << dir.lastFileDeleted << dir.fileSystemWatcherEnabled << dir.paused;
+    }
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+/*!
+ * \brief Populates dirInfo() and devInfo() from the snapshot at snapshotPath().
+ * \remarks
+ * - Does nothing if information has already been received from Syncthing.
+ * - Discards directories and devices restored from a previous snapshot if the snapshot can not be loaded.
+ * - Emits newConfig() and newConfigApplied() with isResettingDirsAndDevs() returning true so models are reset.
+ * \returns Returns whether a snapshot could be loaded.
+ */
+bool SyncthingConnection::loadSnapshot()
+{
+    if (m_hasConfig) {
+        return false;
+    }
+    m_resettingDirsAndDevs = true;
+    emit newConfig(m_rawConfig);
+    const auto restored = restoreSnapshot();
+    if (!restored && m_hasStaleDirsAndDevs) {
+        m_dirs.clear();
+        m_devs.clear();
+        m_dirIds.clearRows();
+        m_devIds.clearRows();
+        m_dirStatusTable.clear();
+        m_dirPathIndex.clear();
+        m_devStatusTable.clear();
+        m_completion.clear();
+        m_hasStaleDirsAndDevs = false;
+    }
+    emit newDevices(m_devs);
+    emit newDirs(m_dirs);
+    emit newConfigApplied();
+    emit dirStatisticsChanged();
+    return restored;
+}
+
+/*!
+ * \brief Saves a snapshot if up-to-date information has been received from Syncthing.
+ */
+void SyncthingConnection::saveSnapshotIfUpToDate()
+{
+    if (m_hasConfig && m_hasStatus && !m_hasStaleDirsAndDevs) {
+        saveSnapshot();
+    }
+}
+
+/*!
+ * \brief Assigns dirInfo() and devInfo() from the snapshot at snapshotPath() without emitting any signals.
+ * \remarks Leaves dirInfo() and devInfo() untouched if the snapshot can not be read.
+ */
+bool SyncthingConnection::restoreSnapshot()
+{
+    if (m_snapshotPath.isEmpty()) {
+        return false;
+    }
+    auto file = QFile(m_snapshotPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    auto in = QDataStream(&file);
+    in.setVersion(snapshotStreamVersion);
+    auto magic = quint32(), version = quint32(), devCount = quint32(), dirCount = quint32();
+    auto myId = QString();
+    in >> magic >> version;
+    if (magic != snapshotMagic || version != snapshotVersion) {
+        return false;
+    }
+    in >> myId >> devCount;
+    auto devs = std::vector<SyncthingDev>();
+    devs.reserve(std::min<std::size_t>(devCount, 4096));
+    for (; devCount && in.status() == QDataStream::Ok; --devCount) {
+        auto &dev = devs.emplace_back();
+        in >> dev.id >> dev.name >> dev.addresses >> dev.compression >> dev.certName >> dev.lastSeen >> dev.introducer >> dev.paused;
+        dev.status = dev.id == myId ? SyncthingDevStatus::OwnDevice : SyncthingDevStatus::Unknown;
+    }
+    in >> dirCount;
+    auto dirs = std::vector<SyncthingDir>();
+    dirs.reserve(std::min<std::size_t>(dirCount, 4096));
+    auto completionByDir = std::vector<CompletionByDevice>();
+    completionByDir.reserve(dirs.capacity());
+    for (auto dirType = qint32(); dirCount && in.status() == QDataStream::Ok; --dirCount) {
+        auto &dir = dirs.emplace_back();
+        in >> dir.id >> dir.label >> dir.path >> dir.deviceIds >> dir.deviceNames >> dirType >> dir.rescanInterval >> dir.minDiskFreePercentage
+            >> dir.fileSystemWatcherDelay >> completionByDir.emplace_back() >> dir.completionPercentage >> dir.globalStats >> dir.localStats
+            >> dir.neededStats >> dir.lastStatisticsUpdate >> dir.lastScanTime >> dir.lastFileTime >> dir.lastFileName >> dir.ignorePermissions
+            >> dir.ignoreDelete >> dir.ignorePatterns >> dir.autoNormalize >> dir.lastFileDeleted >> dir.fileSystemWatcherEnabled >> dir.paused;
+        dir.dirType = static_cast<SyncthingDirType>(dirType);
+        if (m_recentChangesCapacity) {
+            dir.recentChanges.setCapacity(m_recentChangesCapacity);
+        }
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    m_devs.swap(devs);
+    m_dirs.swap(dirs);
+    indexDevs();
+    indexDirs();
+    m_completion.clear();
+    for (auto i = std::size_t(); i != m_dirs.size(); ++i) {
+        const auto dirHandle = m_dirIds.handle(m_dirs[i].id);
+        for (const auto &[devId, completion] : completionByDir[i]) {
+            m_completion.assign(dirHandle, m_devIds.intern(devId), completion);
+        }
+    }
+    for (auto &dev : m_devs) {
+        dev.overallCompletion = m_completion.overallCompletionOfDev(m_devIds.handle(dev.id));
+    }
+    m_recentChangesMemoryUsage = 0;
+    m_hasStaleDirsAndDevs = true;
+    return true;
+}
+
+} // namespace Data
@@ -87,7 +87,9 @@ MockedReply::MockedReply(const string &buffer, int delay, QObject *parent)
     , m_bytesLeft(static_cast<qint64>(m_buffer.size()))
 {
     setOpenMode(QIODevice::ReadOnly);
-    QTimer::singleShot(delay, this, &MockedReply::emitFinished);
+    if (delay >= 0) {
+        QTimer::singleShot(delay, this, &MockedReply::emitFinished);
+    }
 }
 
 MockedReply::~MockedReply()
@@ -209,6 +211,27 @@ MockedReply *MockedReply::forRequest(const QString &method, const QString &path,
     return reply;
 }
 
+/*!
+ * \brief Returns a reply for the specified REST-API \a path which will return the specified \a buffer.
+ * \remarks
+ * - The reply is not finished automatically. Call finish() to emit the finished() signal synchronously.
+ * - The \a buffer must be kept alive as long as the reply is used.
+ */
+MockedReply *MockedReply::forBuffer(const std::string &buffer, const QString &path)
+{
+    auto *const reply = new MockedReply(buffer, -1);
+    reply->setRequest(QNetworkRequest(QUrl(QStringLiteral("mock://rest/") + path)));
+    return reply;
+}
+
+/*!
+ * \brief Finishes the reply immediately.
+ */
+void MockedReply::finish()
+{
+    emitFinished();
+}
+
 void MockedReply::emitFinished()
 {
     if (m_buffer.empty()) {
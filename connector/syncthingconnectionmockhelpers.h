@@ -4,9 +4,11 @@
 /*!
  * \file syncthingconnectionhelper.h
  * \brief Provides helper for mocking SyncthingConnection.
- * \remarks Only include from syncthingconnection.cpp!
+ * \remarks Only include from syncthingconnection.cpp and the connector benchmarks!
  */
 
+#include "./global.h"
+
 #include <c++utilities/conversion/stringbuilder.h>
 #include <c++utilities/io/misc.h>
 #include <c++utilities/tests/testutils.h>
@@ -20,12 +22,12 @@
 
 namespace Data {
 
-void setupTestData();
+LIB_SYNCTHING_CONNECTOR_EXPORT void setupTestData();
 
 /*!
  * \brief The MockedReply class provides a fake QNetworkReply which will just return data from a specified buffer.
  */
-class MockedReply : public QNetworkReply {
+class LIB_SYNCTHING_CONNECTOR_EXPORT MockedReply : public QNetworkReply {
     Q_OBJECT
 
 public:
@@ -44,6 +46,8 @@ public:
     qint64 readData(char *data, qint64 maxlen) override;
 
     static MockedReply *forRequest(const QString &method, const QString &path, const QUrlQuery &query, bool rest);
+    static MockedReply *forBuffer(const std::string &buffer, const QString &path);
+    void finish();
 
 protected:
     MockedReply(const std::string &buffer, int delay, QObject *parent = nullptr);
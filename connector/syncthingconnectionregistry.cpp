@@ -0,0 +1,92 @@
+#include "./syncthingconnectionregistry.h"
+#include "./syncthingconnection.h"
+#include "./syncthingconnectionsettings.h"
+
+#include <algorithm>
+
+namespace Data {
+
+/*!
+ * \brief Returns the global registry.
+ */
+SyncthingConnectionRegistry &SyncthingConnectionRegistry::instance()
+{
+    static auto registry = SyncthingConnectionRegistry();
+    return registry;
+}
+
+/*!
+ * \brief Creates a new connection and registers it so it can be found via find() and acquire().
+ */
+std::shared_ptr<SyncthingConnection> SyncthingConnectionRegistry::create()
+{
+    removeExpiredConnections();
+    auto connection = std::make_shared<SyncthingConnection>();
+    m_connections.emplace_back(connection);
+    return connection;
+}
+
+/*!
+ * \brief Returns the registered connection with the specified \a syncthingUrl and \a apiKey or nullptr if there is none.
+ * \remarks The URL and API key the connections currently have are compared; so a registered connection is still found if
+ *          SyncthingConnection::applySettings() has been used on it.
+ */
+std::shared_ptr<SyncthingConnection> SyncthingConnectionRegistry::find(const QString &syncthingUrl, const QByteArray &apiKey)
+{
+    removeExpiredConnections();
+    for (const auto &weakConnection : m_connections) {
+        if (auto connection = weakConnection.lock(); connection && connection->syncthingUrl() == syncthingUrl && connection->apiKey() == apiKey) {
+            return connection;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Returns the connection to be used for the specified \a settings.
+ * \remarks
+ * - Returns \a currentConnection if it already targets the Syncthing instance specified by \a settings.
+ * - Otherwise returns another registered connection targeting that Syncthing instance if there is one.
+ * - Otherwise returns \a currentConnection if it is not shared with anyone else (so it can simply be reconfigured) or
+ *   a newly created connection.
+ * - The \a settings are applied to the returned connection. \a reconnectRequired is set to whether the returned connection
+ *   needs to be (re)connected for the \a settings to take effect.
+ */
+std::shared_ptr<SyncthingConnection> SyncthingConnectionRegistry::acquire(
+    SyncthingConnectionSettings &settings, const std::shared_ptr<SyncthingConnection> &currentConnection, bool &reconnectRequired)
+{
+    auto connection = std::shared_ptr<SyncthingConnection>();
+    auto created = false;
+    if (currentConnection && currentConnection->syncthingUrl() == settings.syncthingUrl && currentConnection->apiKey() == settings.apiKey) {
+        connection = currentConnection;
+    } else if (!(connection = find(settings.syncthingUrl, settings.apiKey))) {
+        if (currentConnection && currentConnection.use_count() == 1) {
+            connection = currentConnection;
+        } else {
+            connection = create();
+            created = true;
+        }
+    }
+    reconnectRequired = connection->applySettings(settings) || created;
+    return connection;
+}
+
+/*!
+ * \brief Returns the number of connections which are currently in use.
+ */
+std::size_t SyncthingConnectionRegistry::connectionCount()
+{
+    removeExpiredConnections();
+    return m_connections.size();
+}
+
+/*!
+ * \brief Removes connections which have been destroyed from the registry.
+ */
+void SyncthingConnectionRegistry::removeExpiredConnections()
+{
+    m_connections.erase(std::remove_if(m_connections.begin(), m_connections.end(), [](const auto &connection) { return connection.expired(); }),
+        m_connections.end());
+}
+
+} // namespace Data
@@ -0,0 +1,43 @@
+#ifndef DATA_SYNCTHINGCONNECTIONREGISTRY_H
+#define DATA_SYNCTHINGCONNECTIONREGISTRY_H
+
+#include "./global.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace Data {
+
+class SyncthingConnection;
+struct SyncthingConnectionSettings;
+
+/*!
+ * \brief The SyncthingConnectionRegistry class allows sharing SyncthingConnection instances which target the same Syncthing instance.
+ * \remarks
+ * - Connections are considered the same if their URL and API key match. So several widgets and models can subscribe to the
+ *   signals of one connection (and share its long-polling requests and state) instead of each of them connecting on its own.
+ * - Connections are reference-counted via std::shared_ptr and destroyed when the last user releases them. The registry itself
+ *   only holds weak references.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnectionRegistry {
+public:
+    static SyncthingConnectionRegistry &instance();
+
+    std::shared_ptr<SyncthingConnection> create();
+    std::shared_ptr<SyncthingConnection> find(const QString &syncthingUrl, const QByteArray &apiKey);
+    std::shared_ptr<SyncthingConnection> acquire(
+        SyncthingConnectionSettings &settings, const std::shared_ptr<SyncthingConnection> &currentConnection, bool &reconnectRequired);
+    std::size_t connectionCount();
+
+private:
+    void removeExpiredConnections();
+
+    std::vector<std::weak_ptr<SyncthingConnection>> m_connections;
+};
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGCONNECTIONREGISTRY_H
@@ -1,5 +1,9 @@
 #include "./syncthingconnectionsettings.h"
 
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QStringBuilder>
+
 namespace Data {
 
 bool SyncthingConnectionSettings::loadHttpsCert()
@@ -23,4 +27,16 @@ bool SyncthingConnectionSettings::loadHttpsCert()
     // clang-format on
     return true;
 }
+
+/*!
+ * \brief Returns the path within the cache directory to persist the snapshot of the connection to.
+ * \remarks The path is derived from the syncthingUrl so profiles for the same Syncthing instance share the snapshot.
+ * \sa SyncthingConnection::setSnapshotPath()
+ */
+QString SyncthingConnectionSettings::defaultSnapshotPath() const
+{
+    const auto hash = QCryptographicHash::hash(syncthingUrl.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) % QStringLiteral("/snapshots/") % QString::fromLatin1(hash)
+        % QStringLiteral(".bin");
+}
 } // namespace Data
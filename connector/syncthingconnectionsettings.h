@@ -10,6 +10,8 @@
 #include <QSslError>
 #include <QString>
 
+#include <cstddef>
+
 namespace Data {
 
 /*!
@@ -37,17 +39,26 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnectionSettings {
     int trafficPollInterval = defaultTrafficPollInterval;
     int devStatsPollInterval = defaultDevStatusPollInterval;
     int errorsPollInterval = defaultErrorsPollInterval;
+    int maxPollBackoffFactor = defaultMaxPollBackoffFactor;
     int reconnectInterval = defaultReconnectInterval;
+    int maxConcurrentRequests = defaultMaxConcurrentRequests;
+    std::size_t recentChangesCapacity = defaultRecentChangesCapacity;
+    std::size_t recentChangesMemoryBudget = defaultRecentChangesMemoryBudget;
     QString httpsCertPath;
     QList<QSslError> expectedSslErrors;
     SyncthingStatusComputionFlags statusComputionFlags = SyncthingStatusComputionFlags::Default;
     bool autoConnect = false;
     bool loadHttpsCert();
+    QString defaultSnapshotPath() const;
 
     static constexpr int defaultTrafficPollInterval = 5000;
     static constexpr int defaultDevStatusPollInterval = 60000;
     static constexpr int defaultErrorsPollInterval = 30000;
+    static constexpr int defaultMaxPollBackoffFactor = 8;
     static constexpr int defaultReconnectInterval = 0;
+    static constexpr int defaultMaxConcurrentRequests = 16;
+    static constexpr std::size_t defaultRecentChangesCapacity = 200;
+    static constexpr std::size_t defaultRecentChangesMemoryBudget = 8 * 1024 * 1024;
 };
 } // namespace Data
 
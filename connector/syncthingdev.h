@@ -50,7 +50,6 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingDev {
     QString connectionType;
     QString clientVersion;
     CppUtilities::DateTime lastSeen;
-    std::unordered_map<QString, SyncthingCompletion> completionByDir;
     SyncthingCompletion overallCompletion;
     bool introducer = false;
     bool paused = false;
@@ -0,0 +1,49 @@
+#include "./syncthingdevstatustable.h"
+
+namespace Data {
+
+/*!
+ * \brief Re-populates the table from the specified \a devs.
+ */
+void SyncthingDevStatusTable::assign(const std::vector<SyncthingDev> &devs)
+{
+    clear();
+    m_status.reserve(devs.size());
+    m_paused.reserve(devs.size());
+    for (const auto &dev : devs) {
+        m_status.emplace_back(dev.status);
+        m_paused.emplace_back(dev.paused);
+        m_synchronizingCount += dev.status == SyncthingDevStatus::Synchronizing;
+        m_pausedCount += dev.paused;
+    }
+}
+
+/*!
+ * \brief Updates the specified \a row from \a dev.
+ * \remarks Grows the table if \a row is not present yet (e.g. when a device has been appended).
+ */
+void SyncthingDevStatusTable::update(const SyncthingDev &dev, std::size_t row)
+{
+    if (row >= m_status.size()) {
+        m_status.resize(row + 1, SyncthingDevStatus::Unknown);
+        m_paused.resize(row + 1);
+    }
+    m_synchronizingCount = m_synchronizingCount + (dev.status == SyncthingDevStatus::Synchronizing)
+        - (m_status[row] == SyncthingDevStatus::Synchronizing);
+    m_pausedCount = m_pausedCount + dev.paused - m_paused[row];
+    m_status[row] = dev.status;
+    m_paused[row] = dev.paused;
+}
+
+/*!
+ * \brief Removes all rows.
+ */
+void SyncthingDevStatusTable::clear()
+{
+    m_status.clear();
+    m_paused.clear();
+    m_synchronizingCount = 0;
+    m_pausedCount = 0;
+}
+
+} // namespace Data
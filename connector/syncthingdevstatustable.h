@@ -0,0 +1,79 @@
+#ifndef DATA_SYNCTHINGDEVSTATUSTABLE_H
+#define DATA_SYNCTHINGDEVSTATUSTABLE_H
+
+#include "./syncthingdev.h"
+
+#include <vector>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingDevStatusTable class holds the status and paused flag of all devices and counts the devices
+ *        relevant for computing the overall status.
+ * \remarks
+ * - Row i corresponds to SyncthingConnection::devInfo()[i]. The SyncthingDev objects remain the authoritative source;
+ *   the connection updates the table whenever it re-indexes its devices or notifies about a status change of a device.
+ * - The counters are maintained incrementally so computing the overall status does not need to walk the devices.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingDevStatusTable {
+public:
+    void assign(const std::vector<SyncthingDev> &devs);
+    void update(const SyncthingDev &dev, std::size_t row);
+    void clear();
+
+    std::size_t size() const;
+    SyncthingDevStatus status(std::size_t row) const;
+    bool isPaused(std::size_t row) const;
+    std::size_t synchronizingCount() const;
+    std::size_t pausedCount() const;
+
+private:
+    std::vector<SyncthingDevStatus> m_status;
+    std::vector<bool> m_paused;
+    std::size_t m_synchronizingCount = 0;
+    std::size_t m_pausedCount = 0;
+};
+
+/*!
+ * \brief Returns the number of rows.
+ */
+inline std::size_t SyncthingDevStatusTable::size() const
+{
+    return m_status.size();
+}
+
+/*!
+ * \brief Returns the status of the device at the specified \a row.
+ */
+inline SyncthingDevStatus SyncthingDevStatusTable::status(std::size_t row) const
+{
+    return m_status[row];
+}
+
+/*!
+ * \brief Returns whether the device at the specified \a row is paused.
+ */
+inline bool SyncthingDevStatusTable::isPaused(std::size_t row) const
+{
+    return m_paused[row];
+}
+
+/*!
+ * \brief Returns the number of devices with SyncthingDevStatus::Synchronizing.
+ */
+inline std::size_t SyncthingDevStatusTable::synchronizingCount() const
+{
+    return m_synchronizingCount;
+}
+
+/*!
+ * \brief Returns the number of paused devices.
+ */
+inline std::size_t SyncthingDevStatusTable::pausedCount() const
+{
+    return m_pausedCount;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGDEVSTATUSTABLE_H
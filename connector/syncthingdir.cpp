@@ -6,10 +6,119 @@
 #include <QJsonObject>
 #include <QStringBuilder>
 
+#include <algorithm>
+
 using namespace CppUtilities;
 
 namespace Data {
 
+/*!
+ * \brief Sets the max. number of changes to be recorded.
+ * \remarks
+ * - If more changes are recorded, the oldest ones are discarded.
+ * - Invalidates references to all recorded changes.
+ */
+void SyncthingFileChangeBuffer::setCapacity(std::size_t capacity)
+{
+    if (capacity == m_capacity) {
+        return;
+    }
+    auto changes = std::vector<SyncthingFileChange>();
+    const auto discarded = m_size > capacity ? m_size - capacity : 0;
+    m_memoryUsage = 0;
+    if (capacity && m_size) {
+        changes.reserve(m_size - discarded);
+        for (auto index = discarded; index != m_size; ++index) {
+            auto &change = m_changes[(m_first + index) % m_changes.size()];
+            m_memoryUsage += memoryUsage(change);
+            changes.emplace_back(std::move(change));
+        }
+    }
+    m_changes.swap(changes);
+    m_first = 0;
+    m_size -= discarded;
+    m_capacity = capacity;
+}
+
+/*!
+ * \brief Appends the specified \a change evicting the oldest change if capacity() has been reached.
+ * \returns Returns a reference to the appended change which stays valid until the next change is appended or the change
+ *          is evicted.
+ * \remarks Must not be called if capacity() is zero.
+ */
+const SyncthingFileChange &SyncthingFileChangeBuffer::append(SyncthingFileChange &&change)
+{
+    m_memoryUsage += memoryUsage(change);
+    if (m_size == m_changes.size() && m_size < m_capacity) {
+        // grow the storage geometrically up to the capacity (instead of allocating it for the full capacity upfront) so
+        // directories with only a few changes don't use much more memory than accounted by memoryUsage()
+        grow(std::min(m_capacity, std::max(m_size * 2, initialStorageSize)));
+    }
+    if (m_size < m_changes.size()) {
+        // use the next free slot
+        auto &slot = m_changes[(m_first + m_size++) % m_changes.size()];
+        return slot = std::move(change);
+    }
+    // overwrite the oldest change
+    auto &slot = m_changes[m_first];
+    m_memoryUsage -= memoryUsage(slot);
+    m_first = (m_first + 1) % m_changes.size();
+    return slot = std::move(change);
+}
+
+/*!
+ * \brief Discards the oldest change; must not be called if the buffer is empty.
+ * \returns Returns the approximate number of bytes which have been used by the discarded change.
+ * \remarks The storage is released once the last change has been discarded.
+ */
+std::size_t SyncthingFileChangeBuffer::popFront()
+{
+    auto &slot = m_changes[m_first];
+    const auto freed = memoryUsage(slot);
+    slot = SyncthingFileChange();
+    m_first = (m_first + 1) % m_changes.size();
+    m_memoryUsage -= freed;
+    if (!--m_size) {
+        clear();
+    }
+    return freed;
+}
+
+/*!
+ * \brief Moves the recorded changes into a new storage with the specified \a storageSize (which must be at least size()).
+ * \remarks Invalidates references to all recorded changes.
+ */
+void SyncthingFileChangeBuffer::grow(std::size_t storageSize)
+{
+    auto changes = std::vector<SyncthingFileChange>();
+    changes.reserve(storageSize);
+    for (auto index = std::size_t(); index != m_size; ++index) {
+        changes.emplace_back(std::move(m_changes[(m_first + index) % m_changes.size()]));
+    }
+    changes.resize(storageSize);
+    m_changes.swap(changes);
+    m_first = 0;
+}
+
+/*!
+ * \brief Discards all changes.
+ * \remarks Invalidates references to all recorded changes.
+ */
+void SyncthingFileChangeBuffer::clear()
+{
+    m_changes.clear();
+    m_first = m_size = m_memoryUsage = 0;
+}
+
+/*!
+ * \brief Returns the approximate number of bytes used by the specified \a change.
+ */
+std::size_t SyncthingFileChangeBuffer::memoryUsage(const SyncthingFileChange &change)
+{
+    return sizeof(SyncthingFileChange)
+        + static_cast<std::size_t>(change.action.size() + change.type.size() + change.modifiedBy.size() + change.path.size()) * sizeof(QChar);
+}
+
 QString statusString(SyncthingDirStatus status)
 {
     switch (status) {
@@ -191,39 +300,62 @@ QtUtilities::StringView SyncthingDir::pathWithoutTrailingSlash() const
     return dirPath;
 }
 
-bool SyncthingDir::areRemotesUpToDate() const
-{
-    for (const auto &completionForDev : completionByDevice) {
-        if (!completionForDev.second.needed.isNull()) {
-            return false;
-        }
-    }
-    return true;
-}
-
+/*!
+ * \brief Constructs a new SyncthingItemDownloadProgress for the item at \a relativeItemPath within \a containingDirPath.
+ * \remarks Constructing the file info does not access the file system; it is only accessed once the file info is queried.
+ */
 SyncthingItemDownloadProgress::SyncthingItemDownloadProgress(
     const QString &containingDirPath, const QString &relativeItemPath, const QJsonObject &values)
     : relativePath(relativeItemPath)
-    , fileInfo(containingDirPath % QChar('/') % QString(relativeItemPath).replace(QChar('\\'), QChar('/')))
-    , blocksCurrentlyDownloading(values.value(QLatin1String("Pulling")).toInt())
-    , blocksAlreadyDownloaded(values.value(QLatin1String("Pulled")).toInt())
-    , totalNumberOfBlocks(values.value(QLatin1String("Total")).toInt())
-    , downloadPercentage((blocksAlreadyDownloaded > 0 && totalNumberOfBlocks > 0)
-              ? (static_cast<unsigned int>(blocksAlreadyDownloaded) * 100 / static_cast<unsigned int>(totalNumberOfBlocks))
-              : 0)
-    , blocksCopiedFromOrigin(values.value(QLatin1String("CopiedFromOrigin")).toInt())
-    , blocksCopiedFromElsewhere(values.value(QLatin1String("CopiedFromElsewhere")).toInt())
-    , blocksReused(values.value(QLatin1String("Reused")).toInt())
-    , bytesAlreadyHandled(values.value(QLatin1String("BytesDone")).toInt())
-    , totalNumberOfBytes(values.value(QLatin1String("BytesTotal")).toInt())
-    , label(QStringLiteral("%1 / %2 - %3 %")
+    , fileInfo(containingDirPath % QChar('/')
+          % (relativeItemPath.contains(QChar('\\')) ? QString(relativeItemPath).replace(QChar('\\'), QChar('/')) : relativeItemPath))
+{
+    updateValues(values);
+}
+
+/*!
+ * \brief Updates the progress from the specified \a values (as contained by the "DownloadProgress" event).
+ * \remarks The label is only re-formatted if the number of downloaded blocks has changed.
+ * \returns Returns whether any values have changed.
+ */
+bool SyncthingItemDownloadProgress::updateValues(const QJsonObject &values)
+{
+    const auto pulling = values.value(QLatin1String("Pulling")).toInt();
+    const auto pulled = values.value(QLatin1String("Pulled")).toInt();
+    const auto total = values.value(QLatin1String("Total")).toInt();
+    const auto copiedFromOrigin = values.value(QLatin1String("CopiedFromOrigin")).toInt();
+    const auto copiedFromElsewhere = values.value(QLatin1String("CopiedFromElsewhere")).toInt();
+    const auto reused = values.value(QLatin1String("Reused")).toInt();
+    const auto bytesDone = values.value(QLatin1String("BytesDone")).toInt();
+    const auto bytesTotal = values.value(QLatin1String("BytesTotal")).toInt();
+    const auto blocksChanged = label.isEmpty() || pulled != blocksAlreadyDownloaded || total != totalNumberOfBlocks;
+    if (!blocksChanged && pulling == blocksCurrentlyDownloading && copiedFromOrigin == blocksCopiedFromOrigin
+        && copiedFromElsewhere == blocksCopiedFromElsewhere && reused == blocksReused && bytesDone == bytesAlreadyHandled
+        && bytesTotal == totalNumberOfBytes) {
+        return false;
+    }
+    blocksCurrentlyDownloading = pulling;
+    blocksAlreadyDownloaded = pulled;
+    totalNumberOfBlocks = total;
+    blocksCopiedFromOrigin = copiedFromOrigin;
+    blocksCopiedFromElsewhere = copiedFromElsewhere;
+    blocksReused = reused;
+    bytesAlreadyHandled = bytesDone;
+    totalNumberOfBytes = bytesTotal;
+    if (!blocksChanged) {
+        return true;
+    }
+    downloadPercentage = (blocksAlreadyDownloaded > 0 && totalNumberOfBlocks > 0)
+        ? (static_cast<unsigned int>(blocksAlreadyDownloaded) * 100 / static_cast<unsigned int>(totalNumberOfBlocks))
+        : 0;
+    label = QStringLiteral("%1 / %2 - %3 %")
                 .arg(QString::fromLatin1(
                          dataSizeToString(blocksAlreadyDownloaded > 0 ? static_cast<std::uint64_t>(blocksAlreadyDownloaded) * syncthingBlockSize : 0)
                              .data()),
                     QString::fromLatin1(
                         dataSizeToString(totalNumberOfBlocks > 0 ? static_cast<std::uint64_t>(totalNumberOfBlocks) * syncthingBlockSize : 0).data()),
-                    QString::number(downloadPercentage)))
-{
+                    QString::number(downloadPercentage));
+    return true;
 }
 
 SyncthingStatistics &SyncthingStatistics::operator+=(const SyncthingStatistics &other)
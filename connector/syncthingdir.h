@@ -69,9 +69,114 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingFileChange {
     bool local = false;
 };
 
+/*!
+ * \brief The SyncthingFileChangeBuffer class holds the most recent file changes of a directory in a ring buffer.
+ * \remarks
+ * - Appending a change when capacity() has been reached overwrites the oldest change in O(1).
+ * - The storage grows geometrically up to capacity() as changes are appended and is released when the buffer becomes
+ *   empty. Hence references to changes stay valid only until the next change is appended (unless capacity() has already
+ *   been reached), the change is evicted, the buffer is cleared or the capacity is altered.
+ * - The approximate memory used by the recorded changes is tracked as changes are appended and evicted.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingFileChangeBuffer {
+public:
+    explicit SyncthingFileChangeBuffer(std::size_t capacity = defaultCapacity);
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t capacity() const;
+    void setCapacity(std::size_t capacity);
+    std::size_t memoryUsage() const;
+    const SyncthingFileChange &operator[](std::size_t index) const;
+    const SyncthingFileChange &front() const;
+    const SyncthingFileChange &back() const;
+    const SyncthingFileChange &append(SyncthingFileChange &&change);
+    std::size_t popFront();
+    void clear();
+    static std::size_t memoryUsage(const SyncthingFileChange &change);
+
+    static constexpr std::size_t defaultCapacity = 200;
+
+private:
+    void grow(std::size_t storageSize);
+
+    static constexpr std::size_t initialStorageSize = 8;
+
+    std::vector<SyncthingFileChange> m_changes;
+    std::size_t m_first;
+    std::size_t m_size;
+    std::size_t m_capacity;
+    std::size_t m_memoryUsage;
+};
+
+inline SyncthingFileChangeBuffer::SyncthingFileChangeBuffer(std::size_t capacity)
+    : m_first(0)
+    , m_size(0)
+    , m_capacity(capacity)
+    , m_memoryUsage(0)
+{
+}
+
+/*!
+ * \brief Returns the number of recorded changes.
+ */
+inline std::size_t SyncthingFileChangeBuffer::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief Returns whether no changes are recorded.
+ */
+inline bool SyncthingFileChangeBuffer::empty() const
+{
+    return !m_size;
+}
+
+/*!
+ * \brief Returns the max. number of changes to be recorded.
+ */
+inline std::size_t SyncthingFileChangeBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+/*!
+ * \brief Returns the approximate number of bytes used by the recorded changes.
+ */
+inline std::size_t SyncthingFileChangeBuffer::memoryUsage() const
+{
+    return m_memoryUsage;
+}
+
+/*!
+ * \brief Returns the change with the specified \a index where 0 refers to the oldest change.
+ */
+inline const SyncthingFileChange &SyncthingFileChangeBuffer::operator[](std::size_t index) const
+{
+    return m_changes[(m_first + index) % m_changes.size()];
+}
+
+/*!
+ * \brief Returns the oldest change; must not be called if the buffer is empty.
+ */
+inline const SyncthingFileChange &SyncthingFileChangeBuffer::front() const
+{
+    return m_changes[m_first];
+}
+
+/*!
+ * \brief Returns the most recent change; must not be called if the buffer is empty.
+ */
+inline const SyncthingFileChange &SyncthingFileChangeBuffer::back() const
+{
+    return (*this)[m_size - 1];
+}
+
 struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingItemDownloadProgress {
     explicit SyncthingItemDownloadProgress(
         const QString &containingDirPath = QString(), const QString &relativeItemPath = QString(), const QJsonObject &values = QJsonObject());
+    bool updateValues(const QJsonObject &values);
     QString relativePath;
     QFileInfo fileInfo;
     int blocksCurrentlyDownloading = 0;
@@ -81,7 +186,7 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingItemDownloadProgress {
     int blocksCopiedFromOrigin = 0;
     int blocksCopiedFromElsewhere = 0;
     int blocksReused = 0;
-    int bytesAlreadyHandled;
+    int bytesAlreadyHandled = 0;
     int totalNumberOfBytes = 0;
     QString label;
     CppUtilities::DateTime lastUpdate;
@@ -134,7 +239,6 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingDir {
     QString dirTypeString() const;
     QtUtilities::StringView pathWithoutTrailingSlash() const;
     bool isLocallyUpToDate() const;
-    bool areRemotesUpToDate() const;
     bool isUnshared() const;
 
     QString id;
@@ -152,11 +256,10 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingDir {
     int scanningPercentage = 0;
     double scanningRate = 0;
     double fileSystemWatcherDelay = 0.0;
-    std::unordered_map<QString, SyncthingCompletion> completionByDevice;
     QString globalError;
     quint64 pullErrorCount = 0;
     std::vector<SyncthingItemError> itemErrors;
-    std::vector<SyncthingFileChange> recentChanges;
+    SyncthingFileChangeBuffer recentChanges;
     SyncthingStatistics globalStats, localStats, neededStats;
     CppUtilities::DateTime lastStatisticsUpdate;
     CppUtilities::DateTime lastScanTime;
@@ -217,6 +320,8 @@ inline bool SyncthingDir::assignStatus(SyncthingDirStatus newStatus, CppUtilitie
     return finalizeStatusUpdate(newStatus, time);
 }
 
+class SyncthingDirStatusTable;
+
 struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingOverallDirStatistics {
     Q_GADGET
     Q_PROPERTY(SyncthingStatistics local MEMBER local)
@@ -226,6 +331,7 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingOverallDirStatistics {
 public:
     explicit SyncthingOverallDirStatistics();
     explicit SyncthingOverallDirStatistics(const std::vector<SyncthingDir> &directories);
+    explicit SyncthingOverallDirStatistics(const SyncthingDirStatusTable &statusTable);
 
     SyncthingStatistics local;
     SyncthingStatistics global;
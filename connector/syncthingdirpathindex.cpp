@@ -0,0 +1,98 @@
+#include "./syncthingdirpathindex.h"
+
+#include <QStringBuilder>
+
+namespace Data {
+
+/// \cond
+static int sizeWithoutTrailingSlashes(const QString &path)
+{
+    auto size = path.size();
+    for (; size > 0 && path.at(size - 1) == QChar('/'); --size)
+        ;
+    return size;
+}
+/// \endcond
+
+/*!
+ * \brief Re-populates the index from the specified \a dirs.
+ * \remarks Directories without path are skipped. If the same path is present multiple times, the first occurrence is indexed.
+ */
+void SyncthingDirPathIndex::assign(const std::vector<SyncthingDir> &dirs)
+{
+    m_rows.clear();
+    m_rows.reserve(dirs.size());
+    auto row = 0;
+    for (const auto &dir : dirs) {
+        if (!dir.path.isEmpty()) {
+            m_rows.try_emplace(dir.path.left(sizeWithoutTrailingSlashes(dir.path)), row);
+        }
+        ++row;
+    }
+}
+
+/*!
+ * \brief Removes all paths from the index.
+ */
+void SyncthingDirPathIndex::clear()
+{
+    m_rows.clear();
+}
+
+/*!
+ * \brief Returns the row of the deepest directory containing the specified \a path (or being \a path itself).
+ * \remarks The relative path of the match is the path of the item relative to the directory (without leading slash); it
+ *          is empty if \a path is the path of the directory itself. The row of the match is -1 if no directory contains
+ *          \a path.
+ */
+SyncthingDirPathIndex::Match SyncthingDirPathIndex::find(const QString &path) const
+{
+    for (auto size = sizeWithoutTrailingSlashes(path);;) {
+        if (const auto i = m_rows.find(size == path.size() ? path : path.left(size)); i != m_rows.end()) {
+            return Match{ i->second, size < path.size() ? path.mid(size + 1) : QString() };
+        }
+        if (size <= 0 || (size = path.lastIndexOf(QChar('/'), size - 1)) < 0) {
+            return Match();
+        }
+    }
+}
+
+/*!
+ * \brief Returns the matches for the specified \a paths; the match at index i corresponds to paths[i].
+ * \remarks Paths within the same parent directory (e.g. the selection within a file browser) share the lookup of their
+ *          parent directory, so the costs are mostly one hash lookup per path.
+ */
+std::vector<SyncthingDirPathIndex::Match> SyncthingDirPathIndex::find(const QStringList &paths) const
+{
+    auto matches = std::vector<Match>();
+    auto matchesByParent = std::unordered_map<QString, Match>();
+    matches.reserve(static_cast<std::size_t>(paths.size()));
+    for (const auto &path : paths) {
+        const auto size = sizeWithoutTrailingSlashes(path);
+        const auto normalizedPath = size == path.size() ? path : path.left(size);
+        if (const auto i = m_rows.find(normalizedPath); i != m_rows.end()) {
+            matches.emplace_back(Match{ i->second, QString() });
+            continue;
+        }
+        const auto lastSep = normalizedPath.lastIndexOf(QChar('/'));
+        if (lastSep < 0) {
+            matches.emplace_back();
+            continue;
+        }
+        auto [parentMatch, isNewParent] = matchesByParent.try_emplace(normalizedPath.left(lastSep));
+        if (isNewParent) {
+            parentMatch->second = find(parentMatch->first);
+        }
+        const auto &[row, parentPath] = parentMatch->second;
+        if (row < 0) {
+            matches.emplace_back();
+        } else if (parentPath.isEmpty()) {
+            matches.emplace_back(Match{ row, path.mid(lastSep + 1) });
+        } else {
+            matches.emplace_back(Match{ row, parentPath % QChar('/') % path.mid(lastSep + 1) });
+        }
+    }
+    return matches;
+}
+
+} // namespace Data
@@ -0,0 +1,52 @@
+#ifndef DATA_SYNCTHINGDIRPATHINDEX_H
+#define DATA_SYNCTHINGDIRPATHINDEX_H
+
+#include "./qstringhash.h"
+#include "./syncthingdir.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingDirPathIndex class maps paths to the directory containing them.
+ * \remarks
+ * - Directories are indexed by their path without trailing slash. Looking up the directory containing a path walks the
+ *   path from the end towards the root, one path component at a time, so a query takes as many hash lookups as the path
+ *   has components instead of comparing the path with the paths of all directories.
+ * - Because the walk starts at the end, the deepest directory is found if directories are nested.
+ * - Row i corresponds to SyncthingConnection::dirInfo()[i]. The connection re-assigns the index whenever its directories
+ *   or their paths change.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingDirPathIndex {
+public:
+    struct Match {
+        int row = -1;
+        QString relativePath;
+    };
+
+    void assign(const std::vector<SyncthingDir> &dirs);
+    void clear();
+    std::size_t size() const;
+    Match find(const QString &path) const;
+    std::vector<Match> find(const QStringList &paths) const;
+
+private:
+    std::unordered_map<QString, int> m_rows;
+};
+
+/*!
+ * \brief Returns the number of indexed paths.
+ */
+inline std::size_t SyncthingDirPathIndex::size() const
+{
+    return m_rows.size();
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGDIRPATHINDEX_H
@@ -0,0 +1,89 @@
+#include "./syncthingdirstatustable.h"
+
+namespace Data {
+
+/*!
+ * \brief Computes overall statistics for the directories within the specified \a statusTable.
+ */
+SyncthingOverallDirStatistics::SyncthingOverallDirStatistics(const SyncthingDirStatusTable &statusTable)
+{
+    for (auto row = std::size_t(), size = statusTable.size(); row != size; ++row) {
+        local += statusTable.localStats(row);
+        global += statusTable.globalStats(row);
+        needed += statusTable.neededStats(row);
+    }
+}
+
+/*!
+ * \brief Returns the counter for the specified \a status.
+ * \remarks Statuses out of the range of SyncthingDirStatus are counted as SyncthingDirStatus::Unknown.
+ */
+std::size_t &SyncthingDirStatusTable::countOf(SyncthingDirStatus status)
+{
+    const auto index = static_cast<std::size_t>(status);
+    return m_statusCounts[index < m_statusCounts.size() ? index : static_cast<std::size_t>(SyncthingDirStatus::Unknown)];
+}
+
+/*!
+ * \brief Re-populates the table from the specified \a dirs.
+ */
+void SyncthingDirStatusTable::assign(const std::vector<SyncthingDir> &dirs)
+{
+    clear();
+    m_status.reserve(dirs.size());
+    m_paused.reserve(dirs.size());
+    m_localStats.reserve(dirs.size());
+    m_globalStats.reserve(dirs.size());
+    m_neededStats.reserve(dirs.size());
+    m_lastStatisticsUpdate.reserve(dirs.size());
+    for (const auto &dir : dirs) {
+        m_status.emplace_back(dir.status);
+        ++countOf(dir.status);
+        m_paused.emplace_back(dir.paused);
+        m_localStats.emplace_back(dir.localStats);
+        m_globalStats.emplace_back(dir.globalStats);
+        m_neededStats.emplace_back(dir.neededStats);
+        m_lastStatisticsUpdate.emplace_back(dir.lastStatisticsUpdate);
+    }
+}
+
+/*!
+ * \brief Updates the specified \a row from \a dir.
+ * \remarks Grows the table if \a row is not present yet (e.g. when a directory has been appended).
+ */
+void SyncthingDirStatusTable::update(const SyncthingDir &dir, std::size_t row)
+{
+    if (row >= m_status.size()) {
+        countOf(SyncthingDirStatus::Unknown) += row + 1 - m_status.size();
+        m_status.resize(row + 1, SyncthingDirStatus::Unknown);
+        m_paused.resize(row + 1);
+        m_localStats.resize(row + 1);
+        m_globalStats.resize(row + 1);
+        m_neededStats.resize(row + 1);
+        m_lastStatisticsUpdate.resize(row + 1);
+    }
+    --countOf(m_status[row]);
+    ++countOf(dir.status);
+    m_status[row] = dir.status;
+    m_paused[row] = dir.paused;
+    m_localStats[row] = dir.localStats;
+    m_globalStats[row] = dir.globalStats;
+    m_neededStats[row] = dir.neededStats;
+    m_lastStatisticsUpdate[row] = dir.lastStatisticsUpdate;
+}
+
+/*!
+ * \brief Removes all rows.
+ */
+void SyncthingDirStatusTable::clear()
+{
+    m_statusCounts = {};
+    m_status.clear();
+    m_paused.clear();
+    m_localStats.clear();
+    m_globalStats.clear();
+    m_neededStats.clear();
+    m_lastStatisticsUpdate.clear();
+}
+
+} // namespace Data
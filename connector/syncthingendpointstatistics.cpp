@@ -0,0 +1,26 @@
+#include "./syncthingendpointstatistics.h"
+
+#include <cmath>
+
+namespace Data {
+
+/*!
+ * \brief Returns an approximation of the specified \a percentage (0 to 100) of the values recorded so far.
+ * \remarks Returns the upper bound of the bucket the percentile falls into but at most the biggest value recorded.
+ */
+std::uint64_t SyncthingHistogram::percentile(double percentage) const
+{
+    if (!count) {
+        return 0;
+    }
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(static_cast<double>(count) * percentage / 100.0)));
+    auto seen = std::uint64_t();
+    for (auto i = std::size_t(); i != bucketCount; ++i) {
+        if ((seen += buckets[i]) >= rank) {
+            return std::min(bucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
+
+} // namespace Data
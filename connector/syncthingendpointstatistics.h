@@ -0,0 +1,91 @@
+#ifndef DATA_SYNCTHINGENDPOINTSTATISTICS_H
+#define DATA_SYNCTHINGENDPOINTSTATISTICS_H
+
+#include "./global.h"
+
+#include <QString>
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingHistogram struct is a histogram with exponentially growing buckets.
+ * \remarks
+ * - Bucket 0 holds zero values and bucket i > 0 holds values within [2^(i-1), 2^i). The last bucket holds all values
+ *   exceeding the range of the previous buckets.
+ * - Recording a value is cheap (no allocations, just a few integer operations) so histograms can be populated all the
+ *   time. Percentiles are approximated by the upper bound of the bucket they fall into.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingHistogram {
+    static constexpr std::size_t bucketCount = 40;
+
+    void record(std::uint64_t value);
+    std::uint64_t mean() const;
+    std::uint64_t percentile(double percentage) const;
+    static constexpr std::uint64_t bucketUpperBound(std::size_t bucketIndex);
+
+    std::array<std::uint64_t, bucketCount> buckets = {}; /**< the number of values recorded per bucket */
+    std::uint64_t count = 0; /**< the number of values recorded */
+    std::uint64_t total = 0; /**< the sum of all values recorded */
+    std::uint64_t max = 0; /**< the biggest value recorded */
+};
+
+/*!
+ * \brief Records the specified \a value.
+ */
+inline void SyncthingHistogram::record(std::uint64_t value)
+{
+    // the bucket index is the number of significant bits of value (0 for 0)
+    const auto bitWidth = static_cast<std::size_t>(64 - qCountLeadingZeroBits(static_cast<quint64>(value)));
+    ++buckets[std::min<std::size_t>(bitWidth, bucketCount - 1)];
+    ++count;
+    total += value;
+    max = std::max(max, value);
+}
+
+/*!
+ * \brief Returns the mean of all values recorded so far or zero if no values have been recorded.
+ */
+inline std::uint64_t SyncthingHistogram::mean() const
+{
+    return count ? total / count : 0;
+}
+
+/*!
+ * \brief Returns the biggest value the bucket with the specified \a bucketIndex can hold.
+ */
+constexpr std::uint64_t SyncthingHistogram::bucketUpperBound(std::size_t bucketIndex)
+{
+    return bucketIndex + 1 >= bucketCount ? UINT64_MAX : (std::uint64_t(1) << bucketIndex) - 1;
+}
+
+/*!
+ * \brief The SyncthingEndpointStatistics struct holds metrics about the requests made to a certain REST-API endpoint.
+ * \remarks
+ * - All times are in microseconds and all sizes in bytes.
+ * - The handler time includes the parse time.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingEndpointStatistics {
+    std::uint64_t requests = 0; /**< the number of requests sent */
+    std::uint64_t replies = 0; /**< the number of replies handled (successfully or not) */
+    std::uint64_t errors = 0; /**< the number of replies with network/HTTP errors (including aborted ones) */
+    SyncthingHistogram timeToFirstByte; /**< the time between sending the request and receiving the response headers */
+    SyncthingHistogram latency; /**< the time between sending the request and receiving the complete response */
+    SyncthingHistogram responseSize; /**< the size of the response body */
+    SyncthingHistogram parseTime; /**< the time spent on parsing the response */
+    SyncthingHistogram handlerTime; /**< the time spent within the handler of the response */
+};
+
+/*!
+ * \brief The SyncthingEndpointStatisticsMap type maps REST-API paths (e.g. "system/config") to their statistics.
+ */
+using SyncthingEndpointStatisticsMap = std::map<QString, SyncthingEndpointStatistics>;
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGENDPOINTSTATISTICS_H
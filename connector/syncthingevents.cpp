@@ -0,0 +1,375 @@
+#include "./syncthingevents.h"
+
+#include <QJsonParseError>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
+
+namespace Data {
+
+/// \cond
+namespace {
+
+struct EventTypeEntry {
+    std::string_view name;
+    SyncthingEventType type;
+};
+
+/*!
+ * \brief Table of handled event types, sorted by name to allow binary search.
+ * \remarks The order matches the order of SyncthingEventType so syncthingEventTypeName() can index it directly.
+ */
+constexpr auto eventTypeTable = std::array<EventTypeEntry, 22>{ {
+    { "ConfigSaved", SyncthingEventType::ConfigSaved },
+    { "DeviceConnected", SyncthingEventType::DeviceConnected },
+    { "DeviceDisconnected", SyncthingEventType::DeviceDisconnected },
+    { "DeviceDiscovered", SyncthingEventType::DeviceDiscovered },
+    { "DevicePaused", SyncthingEventType::DevicePaused },
+    { "DeviceRejected", SyncthingEventType::DeviceRejected },
+    { "DeviceResumed", SyncthingEventType::DeviceResumed },
+    { "DownloadProgress", SyncthingEventType::DownloadProgress },
+    { "FolderCompletion", SyncthingEventType::FolderCompletion },
+    { "FolderErrors", SyncthingEventType::FolderErrors },
+    { "FolderPaused", SyncthingEventType::FolderPaused },
+    { "FolderRejected", SyncthingEventType::FolderRejected },
+    { "FolderResumed", SyncthingEventType::FolderResumed },
+    { "FolderScanProgress", SyncthingEventType::FolderScanProgress },
+    { "FolderSummary", SyncthingEventType::FolderSummary },
+    { "ItemFinished", SyncthingEventType::ItemFinished },
+    { "ItemStarted", SyncthingEventType::ItemStarted },
+    { "LocalChangeDetected", SyncthingEventType::LocalChangeDetected },
+    { "RemoteChangeDetected", SyncthingEventType::RemoteChangeDetected },
+    { "RemoteIndexUpdated", SyncthingEventType::RemoteIndexUpdated },
+    { "Starting", SyncthingEventType::Starting },
+    { "StateChanged", SyncthingEventType::StateChanged },
+} };
+
+constexpr bool isEventTypeTableValid()
+{
+    for (std::size_t i = 0; i != eventTypeTable.size(); ++i) {
+        if (static_cast<std::size_t>(eventTypeTable[i].type) != i + 1) {
+            return false;
+        }
+        if (i && !(eventTypeTable[i - 1].name < eventTypeTable[i].name)) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(isEventTypeTableValid(), "event type table must be sorted by name and match the order of SyncthingEventType");
+static_assert(eventTypeTable.size() <= sizeof(SyncthingEventTypeMask) * 8, "SyncthingEventTypeMask must be able to hold all event types");
+static_assert(allSyncthingEventTypes == (syncthingEventTypeFlag(eventTypeTable.back().type) * 2 - 1), "last event type must be StateChanged");
+
+/*!
+ * \brief The EventScanner class splits a reply of Syncthing's event API into SyncthingEventRecord objects.
+ * \remarks
+ * - Only the top-level array and the event objects are actually examined; all other values are merely skipped
+ *   so no DOM and no strings are created.
+ * - The JSON is validated only as far as necessary to find the boundaries of the values. The event data is
+ *   fully validated later when being parsed via QJsonDocument.
+ */
+class EventScanner {
+public:
+    explicit EventScanner(std::string_view json);
+    std::vector<SyncthingEventRecord> scan(QJsonParseError &error);
+
+private:
+    void skipWhitespace();
+    bool expect(char c, QJsonParseError::ParseError errorIfNot);
+    bool scanString(std::string_view &content);
+    bool skipValue(std::string_view &value, int depth = 0);
+    bool scanEvent(SyncthingEventRecord &record);
+    bool fail(QJsonParseError::ParseError error);
+
+    const char *const m_begin;
+    const char *const m_end;
+    const char *m_i;
+    QJsonParseError::ParseError m_error;
+};
+
+EventScanner::EventScanner(std::string_view json)
+    : m_begin(json.data())
+    , m_end(json.data() + json.size())
+    , m_i(json.data())
+    , m_error(QJsonParseError::NoError)
+{
+}
+
+void EventScanner::skipWhitespace()
+{
+    for (; m_i != m_end && (*m_i == ' ' || *m_i == '\n' || *m_i == '\r' || *m_i == '\t'); ++m_i)
+        ;
+}
+
+bool EventScanner::fail(QJsonParseError::ParseError error)
+{
+    m_error = error;
+    return false;
+}
+
+bool EventScanner::expect(char c, QJsonParseError::ParseError errorIfNot)
+{
+    skipWhitespace();
+    if (m_i == m_end || *m_i != c) {
+        return fail(errorIfNot);
+    }
+    ++m_i;
+    return true;
+}
+
+bool EventScanner::scanString(std::string_view &content)
+{
+    const auto *const start = ++m_i;
+    for (; m_i != m_end; ++m_i) {
+        switch (*m_i) {
+        case '"':
+            content = std::string_view(start, static_cast<std::size_t>(m_i++ - start));
+            return true;
+        case '\\':
+            if (++m_i == m_end) {
+                return fail(QJsonParseError::IllegalEscapeSequence);
+            }
+            break;
+        default:;
+        }
+    }
+    return fail(QJsonParseError::UnterminatedString);
+}
+
+bool EventScanner::skipValue(std::string_view &value, int depth)
+{
+    static constexpr auto maxDepth = 1024;
+    skipWhitespace();
+    if (m_i == m_end) {
+        return fail(QJsonParseError::IllegalValue);
+    }
+    const auto *const start = m_i;
+    auto content = std::string_view();
+    switch (*m_i) {
+    case '"':
+        if (!scanString(content)) {
+            return false;
+        }
+        break;
+    case '{':
+    case '[': {
+        if (depth >= maxDepth) {
+            return fail(QJsonParseError::DeepNesting);
+        }
+        const auto isObject = *m_i++ == '{';
+        const auto closing = isObject ? '}' : ']';
+        const auto unterminated = isObject ? QJsonParseError::UnterminatedObject : QJsonParseError::UnterminatedArray;
+        skipWhitespace();
+        if (m_i != m_end && *m_i == closing) {
+            ++m_i;
+            break;
+        }
+        for (;;) {
+            if (isObject) {
+                skipWhitespace();
+                if (m_i == m_end || *m_i != '"') {
+                    return fail(unterminated);
+                }
+                if (!scanString(content) || !expect(':', QJsonParseError::MissingNameSeparator)) {
+                    return false;
+                }
+            }
+            if (!skipValue(content, depth + 1)) {
+                return false;
+            }
+            skipWhitespace();
+            if (m_i == m_end) {
+                return fail(unterminated);
+            }
+            if (*m_i == closing) {
+                ++m_i;
+                break;
+            }
+            if (*m_i++ != ',') {
+                return fail(isObject ? QJsonParseError::MissingValueSeparator : unterminated);
+            }
+        }
+        break;
+    }
+    case 't':
+    case 'f':
+    case 'n': {
+        const auto literal = *m_i == 't' ? std::string_view("true") : (*m_i == 'f' ? std::string_view("false") : std::string_view("null"));
+        if (static_cast<std::size_t>(m_end - m_i) < literal.size() || std::string_view(m_i, literal.size()) != literal) {
+            return fail(QJsonParseError::IllegalValue);
+        }
+        m_i += literal.size();
+        break;
+    }
+    default:
+        for (; m_i != m_end && ((*m_i >= '0' && *m_i <= '9') || *m_i == '-' || *m_i == '+' || *m_i == '.' || *m_i == 'e' || *m_i == 'E'); ++m_i)
+            ;
+        if (m_i == start) {
+            return fail(QJsonParseError::IllegalValue);
+        }
+    }
+    value = std::string_view(start, static_cast<std::size_t>(m_i - start));
+    return true;
+}
+
+bool EventScanner::scanEvent(SyncthingEventRecord &record)
+{
+    ++m_i; // skip '{'
+    skipWhitespace();
+    if (m_i != m_end && *m_i == '}') {
+        ++m_i;
+        return true;
+    }
+    for (auto key = std::string_view(), value = std::string_view();;) {
+        skipWhitespace();
+        if (m_i == m_end || *m_i != '"') {
+            return fail(QJsonParseError::UnterminatedObject);
+        }
+        if (!scanString(key) || !expect(':', QJsonParseError::MissingNameSeparator) || !skipValue(value, 1)) {
+            return false;
+        }
+        if (key == "id") {
+            const auto *const end = value.data() + value.size();
+            const auto [ptr, ec] = std::from_chars(value.data(), end, record.id);
+            record.hasId = ec == std::errc() && ptr == end;
+        } else if (key == "type") {
+            record.type = value.size() >= 2 && value.front() == '"' ? syncthingEventType(value.substr(1, value.size() - 2)) : SyncthingEventType::Unknown;
+        } else if (key == "time") {
+            record.time = value.size() >= 2 && value.front() == '"' ? value.substr(1, value.size() - 2) : std::string_view();
+        } else if (key == "data") {
+            record.data = !value.empty() && value.front() == '{' ? value : std::string_view();
+        }
+        skipWhitespace();
+        if (m_i == m_end) {
+            return fail(QJsonParseError::UnterminatedObject);
+        }
+        if (*m_i == '}') {
+            ++m_i;
+            return true;
+        }
+        if (*m_i++ != ',') {
+            return fail(QJsonParseError::MissingValueSeparator);
+        }
+    }
+}
+
+std::vector<SyncthingEventRecord> EventScanner::scan(QJsonParseError &error)
+{
+    auto records = std::vector<SyncthingEventRecord>();
+    auto value = std::string_view();
+    skipWhitespace();
+    if (m_i != m_end && *m_i == '[') {
+        ++m_i;
+        skipWhitespace();
+        if (m_i != m_end && *m_i == ']') {
+            ++m_i;
+        } else {
+            for (;;) {
+                skipWhitespace();
+                if (m_i != m_end && *m_i == '{') {
+                    if (!scanEvent(records.emplace_back())) {
+                        break;
+                    }
+                } else if (!skipValue(value, 1)) {
+                    break;
+                }
+                skipWhitespace();
+                if (m_i == m_end || (*m_i != ',' && *m_i != ']')) {
+                    fail(QJsonParseError::UnterminatedArray);
+                    break;
+                }
+                if (*m_i++ == ']') {
+                    break;
+                }
+            }
+        }
+    } else {
+        skipValue(value); // tolerate other top-level values like QJsonDocument::array() would do
+    }
+    if (m_error == QJsonParseError::NoError) {
+        skipWhitespace();
+        if (m_i != m_end) {
+            m_error = QJsonParseError::GarbageAtEnd;
+        }
+    }
+    error.error = m_error;
+    error.offset = static_cast<decltype(error.offset)>(m_i - m_begin);
+    if (m_error != QJsonParseError::NoError) {
+        records.clear();
+    }
+    return records;
+}
+
+} // namespace
+/// \endcond
+
+/*!
+ * \brief Returns the SyncthingEventType for the specified \a eventTypeName or SyncthingEventType::Unknown if the type is not handled.
+ */
+SyncthingEventType syncthingEventType(std::string_view eventTypeName)
+{
+    const auto end = eventTypeTable.end();
+    const auto i = std::lower_bound(
+        eventTypeTable.begin(), end, eventTypeName, [](const EventTypeEntry &entry, std::string_view name) { return entry.name < name; });
+    return i != end && i->name == eventTypeName ? i->type : SyncthingEventType::Unknown;
+}
+
+/*!
+ * \brief Returns the SyncthingEventType for the specified \a eventTypeName or SyncthingEventType::Unknown if the type is not handled.
+ * \remarks Does not allocate; the name is compared against the Latin-1 table entries directly.
+ */
+SyncthingEventType syncthingEventType(const QString &eventTypeName)
+{
+    const auto end = eventTypeTable.end();
+    const auto i = std::lower_bound(eventTypeTable.begin(), end, eventTypeName, [](const EventTypeEntry &entry, const QString &name) {
+        return name.compare(QLatin1String(entry.name.data(), static_cast<int>(entry.name.size()))) > 0;
+    });
+    return i != end && eventTypeName == QLatin1String(i->name.data(), static_cast<int>(i->name.size())) ? i->type : SyncthingEventType::Unknown;
+}
+
+/*!
+ * \brief Returns the name of the specified \a eventType as used by Syncthing's event API or an empty string for SyncthingEventType::Unknown.
+ */
+QLatin1String syncthingEventTypeName(SyncthingEventType eventType)
+{
+    const auto index = static_cast<std::size_t>(eventType);
+    if (!index || index > eventTypeTable.size()) {
+        return QLatin1String();
+    }
+    const auto &name = eventTypeTable[index - 1].name;
+    return QLatin1String(name.data(), static_cast<int>(name.size()));
+}
+
+/*!
+ * \brief Returns the value for the "events" parameter of Syncthing's event API to request only the specified \a eventTypes.
+ * \remarks Returns an empty string if \a eventTypes is empty. In this case no filter should be passed at all.
+ */
+QString syncthingEventFilter(SyncthingEventTypeMask eventTypes)
+{
+    auto filter = QString();
+    for (const auto &entry : eventTypeTable) {
+        if (!(eventTypes & syncthingEventTypeFlag(entry.type))) {
+            continue;
+        }
+        if (!filter.isEmpty()) {
+            filter += QChar(',');
+        }
+        filter += QLatin1String(entry.name.data(), static_cast<int>(entry.name.size()));
+    }
+    return filter;
+}
+
+/*!
+ * \brief Splits the specified \a json reply of Syncthing's event API into SyncthingEventRecord objects without building a DOM.
+ * \remarks
+ * - The returned records refer to \a json so it must be kept alive as long as the records are used.
+ * - Returns an empty vector and sets \a error if \a json is malformed; otherwise error.error is set to QJsonParseError::NoError.
+ */
+std::vector<SyncthingEventRecord> scanSyncthingEvents(std::string_view json, QJsonParseError &error)
+{
+    return EventScanner(json).scan(error);
+}
+
+} // namespace Data
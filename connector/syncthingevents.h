@@ -0,0 +1,89 @@
+#ifndef DATA_SYNCTHINGEVENTS_H
+#define DATA_SYNCTHINGEVENTS_H
+
+#include "./global.h"
+
+#include <QLatin1String>
+#include <QString>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+QT_FORWARD_DECLARE_CLASS(QJsonParseError)
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingEventType enum represents the types of events the SyncthingConnection class handles.
+ * \remarks
+ * - Only event types which are actually handled by SyncthingConnection are listed. All other event types Syncthing
+ *   might emit are mapped to SyncthingEventType::Unknown and discarded.
+ * - When adding an item, also add it to the table in syncthingevents.cpp and handle it in
+ *   SyncthingConnection::readEvent().
+ */
+enum class SyncthingEventType : unsigned char {
+    Unknown, /**< an event type not handled by the connector */
+    ConfigSaved, /**< "ConfigSaved" */
+    DeviceConnected, /**< "DeviceConnected" */
+    DeviceDisconnected, /**< "DeviceDisconnected" */
+    DeviceDiscovered, /**< "DeviceDiscovered" */
+    DevicePaused, /**< "DevicePaused" */
+    DeviceRejected, /**< "DeviceRejected" */
+    DeviceResumed, /**< "DeviceResumed" */
+    DownloadProgress, /**< "DownloadProgress" */
+    FolderCompletion, /**< "FolderCompletion" */
+    FolderErrors, /**< "FolderErrors" */
+    FolderPaused, /**< "FolderPaused" */
+    FolderRejected, /**< "FolderRejected" */
+    FolderResumed, /**< "FolderResumed" */
+    FolderScanProgress, /**< "FolderScanProgress" */
+    FolderSummary, /**< "FolderSummary" */
+    ItemFinished, /**< "ItemFinished" */
+    ItemStarted, /**< "ItemStarted" */
+    LocalChangeDetected, /**< "LocalChangeDetected" (only emitted via the disk event API) */
+    RemoteChangeDetected, /**< "RemoteChangeDetected" (only emitted via the disk event API) */
+    RemoteIndexUpdated, /**< "RemoteIndexUpdated" */
+    Starting, /**< "Starting" */
+    StateChanged, /**< "StateChanged" */
+};
+
+/*!
+ * \brief The SyncthingEventTypeMask type is used to denote a set of SyncthingEventType values (one bit per type).
+ */
+using SyncthingEventTypeMask = std::uint32_t;
+
+/*!
+ * \brief Returns the bit of the specified \a eventType within a SyncthingEventTypeMask.
+ */
+constexpr SyncthingEventTypeMask syncthingEventTypeFlag(SyncthingEventType eventType)
+{
+    return eventType == SyncthingEventType::Unknown ? 0 : (SyncthingEventTypeMask(1) << (static_cast<unsigned int>(eventType) - 1));
+}
+
+/*!
+ * \brief A SyncthingEventTypeMask containing all handled event types (relies on SyncthingEventType::StateChanged being the last item).
+ */
+constexpr auto allSyncthingEventTypes = static_cast<SyncthingEventTypeMask>(syncthingEventTypeFlag(SyncthingEventType::StateChanged) * 2 - 1);
+
+/*!
+ * \brief The SyncthingEventRecord struct holds a single event read via scanSyncthingEvents().
+ * \remarks The time and data members refer to the scanned buffer which must be kept alive as long as they are used.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingEventRecord {
+    std::string_view time; /**< the raw timestamp (without quotes) */
+    std::string_view data; /**< the raw JSON object of the event data or an empty view if the event has no data object */
+    int id = 0; /**< the event ID (only meaningful if hasId is set) */
+    bool hasId = false; /**< whether the event has an integral ID */
+    SyncthingEventType type = SyncthingEventType::Unknown; /**< the event type */
+};
+
+LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingEventType syncthingEventType(std::string_view eventTypeName);
+LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingEventType syncthingEventType(const QString &eventTypeName);
+LIB_SYNCTHING_CONNECTOR_EXPORT QLatin1String syncthingEventTypeName(SyncthingEventType eventType);
+LIB_SYNCTHING_CONNECTOR_EXPORT QString syncthingEventFilter(SyncthingEventTypeMask eventTypes);
+LIB_SYNCTHING_CONNECTOR_EXPORT std::vector<SyncthingEventRecord> scanSyncthingEvents(std::string_view json, QJsonParseError &error);
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGEVENTS_H
@@ -0,0 +1,42 @@
+#include "./syncthingidtable.h"
+
+namespace Data {
+
+/*!
+ * \brief Returns the handle for the specified \a id, interning \a id if not done so far.
+ */
+SyncthingIdTable::Handle SyncthingIdTable::intern(const QString &id)
+{
+    const auto [i, inserted] = m_handles.try_emplace(id, static_cast<Handle>(m_ids.size()));
+    if (inserted) {
+        m_ids.emplace_back(i->first);
+    }
+    return i->second;
+}
+
+/*!
+ * \brief Assigns the specified \a row to \a handle; noRow unassigns the row.
+ */
+void SyncthingIdTable::setRow(Handle handle, int row)
+{
+    if (handle >= m_rows.size()) {
+        if (row == noRow) {
+            return;
+        }
+        m_rows.resize(handle + 1, noRow);
+    }
+    auto &assignedRow = m_rows[handle];
+    m_rowCount = m_rowCount + (row != noRow) - (assignedRow != noRow);
+    assignedRow = row;
+}
+
+/*!
+ * \brief Unassigns the rows of all handles; the handles themselves remain valid.
+ */
+void SyncthingIdTable::clearRows()
+{
+    m_rows.clear();
+    m_rowCount = 0;
+}
+
+} // namespace Data
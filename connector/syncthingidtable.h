@@ -0,0 +1,101 @@
+#ifndef DATA_SYNCTHINGIDTABLE_H
+#define DATA_SYNCTHINGIDTABLE_H
+
+#include "./global.h"
+#include "./qstringhash.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingIdTable class interns directory or device IDs and maps them to small integer handles.
+ * \remarks
+ * - Each ID is stored only once; the copies handed out by id() and interned() share its (implicitly shared) UTF-16 data.
+ * - Handles are assigned in ascending order and stay valid for the lifetime of the table so they can be kept in places
+ *   where the item itself might vanish in the meantime (e.g. queued requests and pending replies).
+ * - Additionally, the table maps handles to the row of the corresponding item so looking up an item by handle does not
+ *   require any string hashing.
+ */
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingIdTable {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle invalidHandle = std::numeric_limits<Handle>::max();
+    static constexpr int noRow = -1;
+
+    Handle intern(const QString &id);
+    Handle handle(const QString &id) const;
+    const QString &id(Handle handle) const;
+    const QString &interned(const QString &id) const;
+    std::size_t size() const;
+
+    int row(Handle handle) const;
+    void setRow(Handle handle, int row);
+    void clearRows();
+    std::size_t rowCount() const;
+
+private:
+    std::unordered_map<QString, Handle> m_handles;
+    std::vector<QString> m_ids;
+    std::vector<int> m_rows;
+    std::size_t m_rowCount = 0;
+};
+
+/*!
+ * \brief Returns the handle for the specified \a id or invalidHandle if \a id has not been interned.
+ */
+inline SyncthingIdTable::Handle SyncthingIdTable::handle(const QString &id) const
+{
+    const auto i = m_handles.find(id);
+    return i != m_handles.end() ? i->second : invalidHandle;
+}
+
+/*!
+ * \brief Returns the ID for the specified \a handle; \a handle must have been returned by intern().
+ */
+inline const QString &SyncthingIdTable::id(Handle handle) const
+{
+    return m_ids[handle];
+}
+
+/*!
+ * \brief Returns the interned copy of \a id if \a id has been interned; otherwise returns \a id itself.
+ */
+inline const QString &SyncthingIdTable::interned(const QString &id) const
+{
+    const auto i = m_handles.find(id);
+    return i != m_handles.end() ? i->first : id;
+}
+
+/*!
+ * \brief Returns the number of interned IDs.
+ */
+inline std::size_t SyncthingIdTable::size() const
+{
+    return m_ids.size();
+}
+
+/*!
+ * \brief Returns the row assigned to the specified \a handle or noRow if none has been assigned.
+ */
+inline int SyncthingIdTable::row(Handle handle) const
+{
+    return handle < m_rows.size() ? m_rows[handle] : noRow;
+}
+
+/*!
+ * \brief Returns the number of handles a row has been assigned to.
+ */
+inline std::size_t SyncthingIdTable::rowCount() const
+{
+    return m_rowCount;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGIDTABLE_H
@@ -0,0 +1,504 @@
+#include "../syncthingconnection.h"
+#include "../syncthingconnectionmockhelpers.h"
+
+#include <c++utilities/chrono/datetime.h>
+#include <c++utilities/io/ansiescapecodes.h>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Data;
+using namespace CppUtilities;
+using namespace CppUtilities::EscapeCodes;
+
+/// \cond
+
+/*!
+ * \brief Counts heap allocations made by the whole process while enabled.
+ * \remarks
+ * - Under glibc, malloc() and friends are interposed so allocations made by Qt (e.g. QString, QByteArray and QJsonValue
+ *   data) are counted as well. Otherwise only allocations via the global operator new are counted.
+ * - Frees are not tracked; the figures denote the number/volume of allocations and not the memory usage.
+ */
+namespace AllocationCounter {
+static std::atomic_bool enabled = false;
+static std::atomic_uint64_t count = 0;
+static std::atomic_uint64_t bytes = 0;
+
+static inline void record(std::size_t size)
+{
+    if (enabled.load(std::memory_order_relaxed)) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+} // namespace AllocationCounter
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+
+void *malloc(std::size_t size) noexcept
+{
+    AllocationCounter::record(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+    AllocationCounter::record(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept
+{
+    AllocationCounter::record(size);
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+void *operator new(std::size_t size)
+{
+    AllocationCounter::record(size);
+    if (auto *const ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+/*!
+ * \brief The BenchmarkFixtures struct holds synthetic Syncthing API responses for a certain number of dirs/devs.
+ */
+struct BenchmarkFixtures {
+    explicit BenchmarkFixtures(int dirCount, int devCount);
+
+    std::string config;
+    std::string connections;
+    std::string dirStatistics;
+    QJsonArray events;
+    QJsonObject downloadProgress;
+};
+
+/*!
+ * \brief Returns a device ID for the specified \a index which looks like a real one.
+ */
+static QString benchmarkDevId(int index)
+{
+    return QStringLiteral("%1-MZJNU2Y-IQGDREY-DM2MGTI-MGL3BXN-PQ6W5BM-TBBZ4TJ-XZWICQ2").arg(index, 7, 10, QChar('0'));
+}
+
+/*!
+ * \brief Returns a dir ID for the specified \a index which looks like a real one.
+ */
+static QString benchmarkDirId(int index)
+{
+    return QStringLiteral("%1-3zgnU").arg(index, 5, 36, QChar('0'));
+}
+
+static std::string toJson(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact).toStdString();
+}
+
+/*!
+ * \brief Generates the fixtures.
+ * \remarks Each dir is shared with up to 10 devices and each device gets a connection entry. The event stream contains
+ *          a "StateChanged", "FolderCompletion" and "ItemFinished" event for each dir and a "DeviceConnected" event for
+ *          each device. The download progress contains two items for every other dir.
+ */
+BenchmarkFixtures::BenchmarkFixtures(int dirCount, int devCount)
+{
+    static const auto timeStamp = QStringLiteral("2021-06-02T13:28:01.288181412+02:00");
+    auto devs = QJsonArray(), dirs = QJsonArray();
+    auto connectionsObj = QJsonObject(), dirStatsObj = QJsonObject();
+    auto eventId = 0;
+    const auto makeEvent = [&eventId](const QString &type, QJsonObject &&data) {
+        return QJsonObject({
+            { QStringLiteral("id"), ++eventId },
+            { QStringLiteral("globalID"), eventId },
+            { QStringLiteral("type"), type },
+            { QStringLiteral("time"), timeStamp },
+            { QStringLiteral("data"), std::move(data) },
+        });
+    };
+    for (auto i = 0; i != devCount; ++i) {
+        const auto devId = benchmarkDevId(i);
+        devs.append(QJsonObject({
+            { QStringLiteral("deviceID"), devId },
+            { QStringLiteral("name"), QStringLiteral("Device %1").arg(i) },
+            { QStringLiteral("addresses"), QJsonArray({ QStringLiteral("dynamic") }) },
+            { QStringLiteral("compression"), QStringLiteral("metadata") },
+            { QStringLiteral("introducer"), false },
+            { QStringLiteral("paused"), false },
+        }));
+        connectionsObj.insert(devId,
+            QJsonObject({
+                { QStringLiteral("connected"), true },
+                { QStringLiteral("paused"), false },
+                { QStringLiteral("at"), timeStamp },
+                { QStringLiteral("inBytesTotal"), 1024 * i },
+                { QStringLiteral("outBytesTotal"), 2048 * i },
+                { QStringLiteral("address"), QStringLiteral("192.168.1.%1:22000").arg(i % 256) },
+                { QStringLiteral("clientVersion"), QStringLiteral("v1.18.0") },
+                { QStringLiteral("type"), QStringLiteral("tcp-client") },
+            }));
+        events.append(makeEvent(QStringLiteral("DeviceConnected"),
+            QJsonObject({
+                { QStringLiteral("device"), devId },
+                { QStringLiteral("addr"), QStringLiteral("192.168.1.%1:22000").arg(i % 256) },
+            })));
+    }
+    for (auto i = 0; i != dirCount; ++i) {
+        const auto dirId = benchmarkDirId(i);
+        auto dirDevs = QJsonArray();
+        for (auto j = 0, count = std::min(devCount, 10); j != count; ++j) {
+            dirDevs.append(QJsonObject({ { QStringLiteral("deviceID"), benchmarkDevId((i + j) % devCount) } }));
+        }
+        const auto firstDevId = dirDevs.isEmpty() ? QString() : dirDevs.first().toObject().value(QLatin1String("deviceID")).toString();
+        dirs.append(QJsonObject({
+            { QStringLiteral("id"), dirId },
+            { QStringLiteral("label"), QStringLiteral("Folder %1").arg(i) },
+            { QStringLiteral("path"), QStringLiteral("/home/user/sync/folder-%1").arg(i) },
+            { QStringLiteral("type"), QStringLiteral("sendreceive") },
+            { QStringLiteral("devices"), dirDevs },
+            { QStringLiteral("rescanIntervalS"), 3600 },
+            { QStringLiteral("fsWatcherEnabled"), true },
+            { QStringLiteral("fsWatcherDelayS"), 10 },
+            { QStringLiteral("ignorePerms"), false },
+            { QStringLiteral("autoNormalize"), true },
+            { QStringLiteral("paused"), false },
+        }));
+        dirStatsObj.insert(dirId,
+            QJsonObject({
+                { QStringLiteral("lastScan"), timeStamp },
+                { QStringLiteral("lastFile"),
+                    QJsonObject({
+                        { QStringLiteral("filename"), QStringLiteral("some/file-%1").arg(i) },
+                        { QStringLiteral("at"), timeStamp },
+                        { QStringLiteral("deleted"), false },
+                    }) },
+            }));
+        events.append(makeEvent(QStringLiteral("StateChanged"),
+            QJsonObject({
+                { QStringLiteral("folder"), dirId },
+                { QStringLiteral("from"), QStringLiteral("idle") },
+                { QStringLiteral("to"), QStringLiteral("syncing") },
+            })));
+        events.append(makeEvent(QStringLiteral("FolderCompletion"),
+            QJsonObject({
+                { QStringLiteral("folder"), dirId },
+                { QStringLiteral("device"), firstDevId },
+                { QStringLiteral("completion"), 42.5 },
+                { QStringLiteral("globalBytes"), 104792064 },
+                { QStringLiteral("needBytes"), 47883776 },
+                { QStringLiteral("needItems"), 5 },
+                { QStringLiteral("needDeletes"), 0 },
+            })));
+        events.append(makeEvent(QStringLiteral("ItemFinished"),
+            QJsonObject({
+                { QStringLiteral("folder"), dirId },
+                { QStringLiteral("item"), QStringLiteral("some/file-%1").arg(i) },
+                { QStringLiteral("type"), QStringLiteral("file") },
+                { QStringLiteral("action"), QStringLiteral("update") },
+                { QStringLiteral("error"), QJsonValue() },
+            })));
+        if (i % 2) {
+            continue;
+        }
+        auto items = QJsonObject();
+        for (const auto *const fileName : { "file1", "dir/file2" }) {
+            items.insert(QString::fromUtf8(fileName),
+                QJsonObject({
+                    { QStringLiteral("Total"), 800 },
+                    { QStringLiteral("Pulling"), 2 },
+                    { QStringLiteral("CopiedFromOrigin"), 0 },
+                    { QStringLiteral("Reused"), 633 },
+                    { QStringLiteral("CopiedFromElsewhere"), 0 },
+                    { QStringLiteral("Pulled"), 38 },
+                    { QStringLiteral("BytesTotal"), 104792064 },
+                    { QStringLiteral("BytesDone"), 47883776 },
+                }));
+        }
+        downloadProgress.insert(dirId, items);
+    }
+    config = toJson(QJsonObject({
+        { QStringLiteral("version"), 35 },
+        { QStringLiteral("folders"), dirs },
+        { QStringLiteral("devices"), devs },
+    }));
+    connections = toJson(QJsonObject({
+        { QStringLiteral("total"),
+            QJsonObject({
+                { QStringLiteral("at"), timeStamp },
+                { QStringLiteral("inBytesTotal"), 1024 * devCount },
+                { QStringLiteral("outBytesTotal"), 2048 * devCount },
+            }) },
+        { QStringLiteral("connections"), connectionsObj },
+    }));
+    dirStatistics = toJson(dirStatsObj);
+}
+
+/*!
+ * \brief The BenchmarkResult struct holds the figures measured for one function and fixture size.
+ */
+struct BenchmarkResult {
+    std::string function;
+    int size = 0;
+    int iterations = 0;
+    std::int64_t minNanoseconds = 0;
+    std::int64_t medianNanoseconds = 0;
+    std::int64_t meanNanoseconds = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocatedBytes = 0;
+};
+
+/*!
+ * \brief The ConnectionBenchmarks class measures how the parsing functions of SyncthingConnection scale.
+ * \remarks
+ * - Replies are provided via MockedReply so the functions under test are invoked exactly as when receiving a reply from
+ *   Syncthing (just without event loop and network overhead).
+ * - Allocations are reported per iteration.
+ */
+class ConnectionBenchmarks {
+public:
+    explicit ConnectionBenchmarks(int iterations);
+
+    void run(int size);
+    const std::vector<BenchmarkResult> &results() const;
+
+private:
+    template <typename SetupFunction, typename Function>
+    void measure(const char *functionName, int size, SetupFunction &&setup, Function &&function);
+    static void finishReply(SyncthingConnection &connection, QNetworkReply *&expectedReply, const std::string &buffer, const QString &path,
+        void (SyncthingConnection::*handler)(), bool pooled = false);
+    static std::unique_ptr<SyncthingConnection> makeConnection(const BenchmarkFixtures *fixtures);
+    static std::unique_ptr<SyncthingConnection> makeConnectionWithPooledBuffers(const BenchmarkFixtures *fixtures);
+
+    int m_iterations;
+    std::vector<BenchmarkResult> m_results;
+};
+
+ConnectionBenchmarks::ConnectionBenchmarks(int iterations)
+    : m_iterations(iterations)
+{
+}
+
+const std::vector<BenchmarkResult> &ConnectionBenchmarks::results() const
+{
+    return m_results;
+}
+
+/*!
+ * \brief Invokes the specified \a handler as if the reply for \a path has been received with \a buffer as response.
+ * \remarks If \a pooled is set, the response is read into a pooled buffer as done by SyncthingConnection::requestData() for
+ *          endpoints which are polled repeatedly.
+ */
+void ConnectionBenchmarks::finishReply(SyncthingConnection &connection, QNetworkReply *&expectedReply, const std::string &buffer, const QString &path,
+    void (SyncthingConnection::*handler)(), bool pooled)
+{
+    auto *const reply = MockedReply::forBuffer(buffer, path);
+    if (pooled) {
+        connection.attachReplyBuffer(reply, path);
+    }
+    expectedReply = reply;
+    QObject::connect(reply, &QNetworkReply::finished, &connection, handler);
+    reply->finish();
+}
+
+/*!
+ * \brief Returns a connection which has read the config of the specified \a fixtures (if not nullptr).
+ */
+std::unique_ptr<SyncthingConnection> ConnectionBenchmarks::makeConnection(const BenchmarkFixtures *fixtures)
+{
+    auto connection = std::make_unique<SyncthingConnection>();
+    if (fixtures) {
+        finishReply(*connection, connection->m_configReply, fixtures->config, QStringLiteral("system/config"), &SyncthingConnection::readConfig);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+    return connection;
+}
+
+/*!
+ * \brief Returns a connection like makeConnection() which has already received the replies polled in run() once.
+ * \remarks So the buffer pool is populated as it would be after the first poll and the measurement shows the steady state.
+ */
+std::unique_ptr<SyncthingConnection> ConnectionBenchmarks::makeConnectionWithPooledBuffers(const BenchmarkFixtures *fixtures)
+{
+    auto connection = makeConnection(fixtures);
+    finishReply(*connection, connection->m_connectionsReply, fixtures->connections, QStringLiteral("system/connections"),
+        &SyncthingConnection::readConnections, true);
+    finishReply(*connection, connection->m_dirStatsReply, fixtures->dirStatistics, QStringLiteral("stats/folder"),
+        &SyncthingConnection::readDirStatistics, true);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    return connection;
+}
+
+/*!
+ * \brief Runs \a function m_iterations times and records the time and allocations; \a setup is invoked before each iteration.
+ */
+template <typename SetupFunction, typename Function>
+void ConnectionBenchmarks::measure(const char *functionName, int size, SetupFunction &&setup, Function &&function)
+{
+    auto &result = m_results.emplace_back();
+    auto times = std::vector<std::int64_t>();
+    times.reserve(static_cast<std::size_t>(m_iterations));
+    result.function = functionName;
+    result.size = size;
+    result.iterations = m_iterations;
+    for (auto i = 0; i != m_iterations; ++i) {
+        auto connection = setup();
+        AllocationCounter::count = AllocationCounter::bytes = 0;
+        AllocationCounter::enabled = true;
+        const auto start = std::chrono::steady_clock::now();
+        function(*connection);
+        const auto end = std::chrono::steady_clock::now();
+        AllocationCounter::enabled = false;
+        times.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        result.allocations += AllocationCounter::count;
+        result.allocatedBytes += AllocationCounter::bytes;
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+    std::sort(times.begin(), times.end());
+    auto total = std::int64_t();
+    for (const auto time : times) {
+        total += time;
+    }
+    result.minNanoseconds = times.front();
+    result.medianNanoseconds = times[times.size() / 2];
+    result.meanNanoseconds = total / m_iterations;
+    result.allocations /= static_cast<std::uint64_t>(m_iterations);
+    result.allocatedBytes /= static_cast<std::uint64_t>(m_iterations);
+    cerr << Phrases::Info << functionName << " with " << size << " dirs/devs: " << result.medianNanoseconds / 1000 << " us (median), "
+         << result.allocations << " allocations" << Phrases::End;
+}
+
+/*!
+ * \brief Runs all benchmarks for fixtures with the specified number of dirs and devs.
+ */
+void ConnectionBenchmarks::run(int size)
+{
+    const auto fixtures = BenchmarkFixtures(size, size);
+    const auto withoutConfig = [] { return makeConnection(nullptr); };
+    const auto withConfig = [&fixtures] { return makeConnection(&fixtures); };
+    const auto withPooledBuffers = [&fixtures] { return makeConnectionWithPooledBuffers(&fixtures); };
+
+    measure("readConfig", size, withoutConfig, [&fixtures](SyncthingConnection &connection) {
+        finishReply(connection, connection.m_configReply, fixtures.config, QStringLiteral("system/config"), &SyncthingConnection::readConfig);
+    });
+    measure("readConnections", size, withConfig, [&fixtures](SyncthingConnection &connection) {
+        finishReply(connection, connection.m_connectionsReply, fixtures.connections, QStringLiteral("system/connections"),
+            &SyncthingConnection::readConnections);
+    });
+    measure("readConnectionsPooled", size, withPooledBuffers, [&fixtures](SyncthingConnection &connection) {
+        finishReply(connection, connection.m_connectionsReply, fixtures.connections, QStringLiteral("system/connections"),
+            &SyncthingConnection::readConnections, true);
+    });
+    measure("readDirStatistics", size, withConfig, [&fixtures](SyncthingConnection &connection) {
+        finishReply(
+            connection, connection.m_dirStatsReply, fixtures.dirStatistics, QStringLiteral("stats/folder"), &SyncthingConnection::readDirStatistics);
+    });
+    measure("readDirStatisticsPooled", size, withPooledBuffers, [&fixtures](SyncthingConnection &connection) {
+        finishReply(connection, connection.m_dirStatsReply, fixtures.dirStatistics, QStringLiteral("stats/folder"),
+            &SyncthingConnection::readDirStatistics, true);
+    });
+    measure("readEventsFromJsonArray", size, withConfig, [&fixtures](SyncthingConnection &connection) {
+        auto lastEventId = 0;
+        connection.readEventsFromJsonArray(fixtures.events, lastEventId);
+    });
+    measure("readDownloadProgressEvent", size, withConfig, [&fixtures](SyncthingConnection &connection) {
+        connection.readDownloadProgressEvent(DateTime::gmtNow(), fixtures.downloadProgress);
+    });
+}
+
+/*!
+ * \brief Returns the results as JSON document.
+ */
+static QByteArray resultsToJson(const std::vector<BenchmarkResult> &results)
+{
+    auto array = QJsonArray();
+    for (const auto &result : results) {
+        array.append(QJsonObject({
+            { QStringLiteral("function"), QString::fromStdString(result.function) },
+            { QStringLiteral("size"), result.size },
+            { QStringLiteral("iterations"), result.iterations },
+            { QStringLiteral("minNs"), static_cast<double>(result.minNanoseconds) },
+            { QStringLiteral("medianNs"), static_cast<double>(result.medianNanoseconds) },
+            { QStringLiteral("meanNs"), static_cast<double>(result.meanNanoseconds) },
+            { QStringLiteral("allocations"), static_cast<double>(result.allocations) },
+            { QStringLiteral("allocatedBytes"), static_cast<double>(result.allocatedBytes) },
+        }));
+    }
+    return QJsonDocument(QJsonObject({ { QStringLiteral("benchmarks"), array } })).toJson(QJsonDocument::Indented);
+}
+
+/// \endcond
+
+/*!
+ * \brief Runs the connector benchmarks and prints the results as JSON to stdout.
+ * \remarks
+ * - The fixture sizes can be specified via SYNCTHING_BENCHMARK_SIZES (comma-separated, defaults to "10,1000,10000").
+ * - The number of iterations can be specified via SYNCTHING_BENCHMARK_ITERATIONS (defaults to 5).
+ * - Progress is printed to stderr so stdout contains only the JSON document.
+ */
+int main(int argc, char *argv[])
+{
+    // the mocked connection reads the small mock files on construction so it needs to find them
+    if (!qEnvironmentVariableIsSet("TEST_FILE_PATH")) {
+        qputenv("TEST_FILE_PATH", SYNCTHING_CONNECTOR_TEST_FILE_PATH);
+    }
+    auto app = QCoreApplication(argc, argv);
+    setupTestData();
+
+    auto sizes = std::vector<int>();
+    const auto sizesFromEnv = qEnvironmentVariable("SYNCTHING_BENCHMARK_SIZES", QStringLiteral("10,1000,10000"));
+    for (const auto &size : sizesFromEnv.split(QChar(','))) {
+        if (size.isEmpty()) {
+            continue;
+        }
+        auto ok = false;
+        if (const auto value = size.toInt(&ok); ok && value > 0) {
+            sizes.emplace_back(value);
+        } else {
+            cerr << Phrases::Error << "Invalid fixture size specified: " << size.toStdString() << Phrases::EndFlush;
+            return EXIT_FAILURE;
+        }
+    }
+    auto iterationsOk = false;
+    auto iterations = qEnvironmentVariableIntValue("SYNCTHING_BENCHMARK_ITERATIONS", &iterationsOk);
+    if (!iterationsOk || iterations <= 0) {
+        iterations = 5;
+    }
+
+    auto benchmarks = ConnectionBenchmarks(iterations);
+    for (const auto size : sizes) {
+        benchmarks.run(size);
+    }
+    cout << resultsToJson(benchmarks.results()).data() << flush;
+    return EXIT_SUCCESS;
+}
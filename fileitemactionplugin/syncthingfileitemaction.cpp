@@ -114,20 +114,19 @@ QList<QAction *> SyncthingFileItemAction::createActions(const KFileItemListPrope
     QList<const SyncthingDir *> containingDirs;
     QList<SyncthingItem> detectedItems;
     const SyncthingDir *lastDir = nullptr;
-    for (const SyncthingDir &dir : dirs) {
-        QStringRef dirPath(dir.pathWithoutTrailingSlash());
-        for (const QString &path : std::as_const(paths)) {
-            if (path == dirPath) {
-                lastDir = &dir;
-                if (!detectedDirs.contains(lastDir)) {
-                    detectedDirs << lastDir;
-                }
-            } else if (path.startsWith(dir.path)) {
-                detectedItems << SyncthingItem(&dir, path.mid(dir.path.size()));
-                lastDir = &dir;
-                if (!containingDirs.contains(lastDir)) {
-                    containingDirs << lastDir;
-                }
+    for (const auto &[row, relativePath] : connection.dirPathIndex().find(paths)) {
+        if (row < 0 || static_cast<std::size_t>(row) >= dirs.size()) {
+            continue;
+        }
+        lastDir = &dirs[static_cast<std::size_t>(row)];
+        if (relativePath.isEmpty()) {
+            if (!detectedDirs.contains(lastDir)) {
+                detectedDirs << lastDir;
+            }
+        } else {
+            detectedItems << SyncthingItem(lastDir, relativePath);
+            if (!containingDirs.contains(lastDir)) {
+                containingDirs << lastDir;
             }
         }
     }
@@ -19,6 +19,10 @@ SyncthingDeviceModel::SyncthingDeviceModel(SyncthingConnection &connection, QObj
     , m_devs(connection.devInfo())
 {
     connect(&m_connection, &SyncthingConnection::devStatusChanged, this, &SyncthingDeviceModel::devStatusChanged);
+    connect(&m_connection, &SyncthingConnection::devsAboutToBeInserted, this, &SyncthingDeviceModel::handleDevsAboutToBeInserted);
+    connect(&m_connection, &SyncthingConnection::devsInserted, this, &SyncthingDeviceModel::handleDevsInserted);
+    connect(&m_connection, &SyncthingConnection::devsAboutToBeRemoved, this, &SyncthingDeviceModel::handleDevsAboutToBeRemoved);
+    connect(&m_connection, &SyncthingConnection::devsRemoved, this, &SyncthingDeviceModel::handleDevsRemoved);
 }
 
 QHash<int, QByteArray> SyncthingDeviceModel::roleNames() const
@@ -246,7 +250,7 @@ QVariant SyncthingDeviceModel::data(const QModelIndex &index, int role) const
         case 0:
             return dev.name.isEmpty() ? dev.id : dev.name;
         case 1:
-            return devStatusString(dev);
+            return m_connection.hasStaleDirsAndDevs() && dev.status == SyncthingDevStatus::Unknown ? tr("Last known state") : devStatusString(dev);
         }
         break;
     case Qt::DecorationRole:
@@ -295,7 +299,7 @@ QVariant SyncthingDeviceModel::data(const QModelIndex &index, int role) const
     case IsOwnDevice:
         return dev.status == SyncthingDevStatus::OwnDevice;
     case DeviceStatusString:
-        return devStatusString(dev);
+        return m_connection.hasStaleDirsAndDevs() && dev.status == SyncthingDevStatus::Unknown ? tr("Last known state") : devStatusString(dev);
     case DeviceStatusColor:
         return devStatusColor(dev);
     case DeviceId:
@@ -337,6 +341,26 @@ int SyncthingDeviceModel::columnCount(const QModelIndex &parent) const
     }
 }
 
+void SyncthingDeviceModel::handleDevsAboutToBeInserted(int first, int last)
+{
+    beginInsertRows(QModelIndex(), first, last);
+}
+
+void SyncthingDeviceModel::handleDevsInserted()
+{
+    endInsertRows();
+}
+
+void SyncthingDeviceModel::handleDevsAboutToBeRemoved(int first, int last)
+{
+    beginRemoveRows(QModelIndex(), first, last);
+}
+
+void SyncthingDeviceModel::handleDevsRemoved()
+{
+    endRemoveRows();
+}
+
 void SyncthingDeviceModel::devStatusChanged(const SyncthingDev &, int index)
 {
     const QModelIndex modelIndex1(this->index(index, 0, QModelIndex()));
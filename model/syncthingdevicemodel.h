@@ -42,6 +42,10 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void devStatusChanged(const SyncthingDev &, int index);
+    void handleDevsAboutToBeInserted(int first, int last);
+    void handleDevsInserted();
+    void handleDevsAboutToBeRemoved(int first, int last);
+    void handleDevsRemoved();
     void handleStatusIconsChanged() override;
 
 private:
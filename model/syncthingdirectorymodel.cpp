@@ -25,6 +25,10 @@ SyncthingDirectoryModel::SyncthingDirectoryModel(SyncthingConnection &connection
 {
     updateRowCount();
     connect(&m_connection, &SyncthingConnection::dirStatusChanged, this, &SyncthingDirectoryModel::dirStatusChanged);
+    connect(&m_connection, &SyncthingConnection::dirsAboutToBeInserted, this, &SyncthingDirectoryModel::handleDirsAboutToBeInserted);
+    connect(&m_connection, &SyncthingConnection::dirsInserted, this, &SyncthingDirectoryModel::handleDirsInserted);
+    connect(&m_connection, &SyncthingConnection::dirsAboutToBeRemoved, this, &SyncthingDirectoryModel::handleDirsAboutToBeRemoved);
+    connect(&m_connection, &SyncthingConnection::dirsRemoved, this, &SyncthingDirectoryModel::handleDirsRemoved);
 }
 
 QHash<int, QByteArray> SyncthingDirectoryModel::roleNames() const
@@ -296,7 +300,7 @@ QVariant SyncthingDirectoryModel::data(const QModelIndex &index, int role) const
         case 0:
             return dir.label.isEmpty() ? dir.id : dir.label;
         case 1:
-            return dirStatusString(dir);
+            return m_connection.hasStaleDirsAndDevs() && dir.status == SyncthingDirStatus::Unknown ? tr("Last known state") : dirStatusString(dir);
         }
         break;
     case Qt::DecorationRole:
@@ -349,7 +353,7 @@ QVariant SyncthingDirectoryModel::data(const QModelIndex &index, int role) const
     case DirectoryPaused:
         return dir.paused;
     case DirectoryStatusString:
-        return dirStatusString(dir);
+        return m_connection.hasStaleDirsAndDevs() && dir.status == SyncthingDirStatus::Unknown ? tr("Last known state") : dirStatusString(dir);
     case DirectoryStatusColor:
         return dirStatusColor(dir);
     case DirectoryId:
@@ -434,13 +438,42 @@ void SyncthingDirectoryModel::dirStatusChanged(const SyncthingDir &dir, int inde
 
 void SyncthingDirectoryModel::handleConfigInvalidated()
 {
-    beginResetModel();
+    if (m_connection.isResettingDirsAndDevs()) {
+        beginResetModel();
+    }
 }
 
 void SyncthingDirectoryModel::handleNewConfigAvailable()
 {
-    updateRowCount();
-    endResetModel();
+    if (m_connection.isResettingDirsAndDevs()) {
+        updateRowCount();
+        endResetModel();
+    }
+}
+
+void SyncthingDirectoryModel::handleDirsAboutToBeInserted(int first, int last)
+{
+    beginInsertRows(QModelIndex(), first, last);
+}
+
+void SyncthingDirectoryModel::handleDirsInserted(int first, int last)
+{
+    m_rowCount.insert(m_rowCount.begin() + first, static_cast<size_t>(last - first + 1), 0);
+    for (auto row = static_cast<size_t>(first), end = static_cast<size_t>(last); row <= end; ++row) {
+        m_rowCount[row] = computeDirectoryRowCount(m_dirs[row]);
+    }
+    endInsertRows();
+}
+
+void SyncthingDirectoryModel::handleDirsAboutToBeRemoved(int first, int last)
+{
+    beginRemoveRows(QModelIndex(), first, last);
+}
+
+void SyncthingDirectoryModel::handleDirsRemoved(int first, int last)
+{
+    m_rowCount.erase(m_rowCount.begin() + first, m_rowCount.begin() + last + 1);
+    endRemoveRows();
 }
 
 void SyncthingDirectoryModel::handleStatusIconsChanged()
@@ -45,6 +45,10 @@ private Q_SLOTS:
     void dirStatusChanged(const SyncthingDir &dir, int index);
     void handleConfigInvalidated() override;
     void handleNewConfigAvailable() override;
+    void handleDirsAboutToBeInserted(int first, int last);
+    void handleDirsInserted(int first, int last);
+    void handleDirsAboutToBeRemoved(int first, int last);
+    void handleDirsRemoved(int first, int last);
     void handleStatusIconsChanged() override;
 
 private:
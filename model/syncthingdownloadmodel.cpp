@@ -3,22 +3,29 @@
 #include <syncthingconnector/syncthingconnection.h>
 #include <syncthingconnector/utils.h>
 
+#include <QFileIconProvider>
+#include <QFileInfo>
+#include <QMimeDatabase>
 #include <QStringBuilder>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <memory>
 
 using namespace std;
 using namespace CppUtilities;
 
 namespace Data {
 
-SyncthingDownloadModel::PendingDir::PendingDir(const SyncthingDir *syncthingDir, unsigned int pendingItems)
-    : syncthingDir(syncthingDir)
+SyncthingDownloadModel::PendingDir::PendingDir(std::size_t dirIndex, unsigned int pendingItems)
+    : dirIndex(dirIndex)
     , pendingItems(pendingItems)
 {
 }
 
-bool SyncthingDownloadModel::PendingDir::operator==(const SyncthingDir *dir) const
+bool SyncthingDownloadModel::PendingDir::operator==(std::size_t index) const
 {
-    return syncthingDir == dir;
+    return dirIndex == index;
 }
 
 SyncthingDownloadModel::SyncthingDownloadModel(SyncthingConnection &connection, QObject *parent)
@@ -30,6 +37,13 @@ SyncthingDownloadModel::SyncthingDownloadModel(SyncthingConnection &connection,
     , m_singleColumnMode(true)
 {
     connect(&m_connection, &SyncthingConnection::downloadProgressChanged, this, &SyncthingDownloadModel::downloadProgressChanged);
+    connect(&m_connection, &SyncthingConnection::dirsInserted, this, &SyncthingDownloadModel::handleDirsInserted);
+    connect(&m_connection, &SyncthingConnection::dirsAboutToBeRemoved, this, &SyncthingDownloadModel::handleDirsAboutToBeRemoved);
+    connect(&m_connection, &SyncthingConnection::dirsRemoved, this, &SyncthingDownloadModel::handleDirsRemoved);
+    connect(&m_fileIconTimer, &QTimer::timeout, this, &SyncthingDownloadModel::resolvePendingFileIcons);
+    connect(&m_fileIconWatcher, &QFutureWatcher<FileIconNamesByKey>::finished, this, &SyncthingDownloadModel::handleFileIconsResolved);
+    m_fileIconTimer.setSingleShot(true);
+    m_fileIconTimer.setInterval(0);
 }
 
 QHash<int, QByteArray> SyncthingDownloadModel::roleNames() const
@@ -51,14 +65,22 @@ const SyncthingDir *SyncthingDownloadModel::dirInfo(const QModelIndex &index) co
 {
     return (index.parent().isValid()
             ? dirInfo(index.parent())
-            : (static_cast<size_t>(index.row()) < m_pendingDirs.size() ? m_pendingDirs[static_cast<size_t>(index.row())].syncthingDir : nullptr));
+            : (static_cast<size_t>(index.row()) < m_pendingDirs.size() ? &pendingDirInfo(static_cast<size_t>(index.row())) : nullptr));
+}
+
+/*!
+ * \brief Returns the directory info for the pending dir at the specified \a row which must be valid.
+ */
+const SyncthingDir &SyncthingDownloadModel::pendingDirInfo(std::size_t row) const
+{
+    return m_dirs[m_pendingDirs[row].dirIndex];
 }
 
 const SyncthingItemDownloadProgress *SyncthingDownloadModel::progressInfo(const QModelIndex &index) const
 {
     if (index.parent().isValid() && static_cast<size_t>(index.parent().row()) < m_pendingDirs.size()
-        && static_cast<size_t>(index.row()) < m_pendingDirs[static_cast<size_t>(index.parent().row())].syncthingDir->downloadingItems.size()) {
-        return &(m_pendingDirs[static_cast<size_t>(index.parent().row())].syncthingDir->downloadingItems[static_cast<size_t>(index.row())]);
+        && static_cast<size_t>(index.row()) < pendingDirInfo(static_cast<size_t>(index.parent().row())).downloadingItems.size()) {
+        return &(pendingDirInfo(static_cast<size_t>(index.parent().row())).downloadingItems[static_cast<size_t>(index.row())]);
     } else {
         return nullptr;
     }
@@ -117,7 +139,7 @@ QVariant SyncthingDownloadModel::data(const QModelIndex &index, int role) const
         if (static_cast<size_t>(index.parent().row()) >= m_pendingDirs.size()) {
             return QVariant();
         }
-        const SyncthingDir &dir = *m_pendingDirs[static_cast<size_t>(index.parent().row())].syncthingDir;
+        const SyncthingDir &dir = pendingDirInfo(static_cast<size_t>(index.parent().row()));
         if (static_cast<size_t>(index.row()) < dir.downloadingItems.size()) {
             const SyncthingItemDownloadProgress &progress = dir.downloadingItems[static_cast<size_t>(index.row())];
             switch (role) {
@@ -135,7 +157,7 @@ QVariant SyncthingDownloadModel::data(const QModelIndex &index, int role) const
             case Qt::DecorationRole:
                 switch (index.column()) {
                 case 0: // file icon
-                    return progress.fileInfo.exists() ? m_fileIconProvider.icon(progress.fileInfo) : m_unknownIcon;
+                    return fileIcon(progress);
                 default:;
                 }
                 break;
@@ -156,7 +178,7 @@ QVariant SyncthingDownloadModel::data(const QModelIndex &index, int role) const
     }
 
     // dir IDs and overall dir progress
-    const SyncthingDir &dir = *m_pendingDirs[static_cast<size_t>(index.row())].syncthingDir;
+    const SyncthingDir &dir = pendingDirInfo(static_cast<size_t>(index.row()));
     switch (role) {
     case Qt::DisplayRole:
     case Qt::EditRole:
@@ -218,12 +240,65 @@ int SyncthingDownloadModel::columnCount(const QModelIndex &parent) const
 }
 
 void SyncthingDownloadModel::handleConfigInvalidated()
+{
+    // keep pending dirs if dirs are only updated in place; insertions/removals shifting the indexes of the pending dirs
+    // are handled via handleDirsInserted(), handleDirsAboutToBeRemoved() and handleDirsRemoved()
+    if (m_connection.isResettingDirsAndDevs()) {
+        resetPendingDirs();
+    }
+}
+
+void SyncthingDownloadModel::resetPendingDirs()
 {
     beginResetModel();
     m_pendingDirs.clear();
     endResetModel();
 }
 
+/*!
+ * \brief Shifts the indexes of pending dirs after the inserted dirs; no rows need to be inserted as new dirs are not pending yet.
+ */
+void SyncthingDownloadModel::handleDirsInserted(int first, int last)
+{
+    const auto count = static_cast<std::size_t>(last - first + 1);
+    for (auto &pendingDir : m_pendingDirs) {
+        if (pendingDir.dirIndex >= static_cast<std::size_t>(first)) {
+            pendingDir.dirIndex += count;
+        }
+    }
+}
+
+/*!
+ * \brief Removes the rows of the pending dirs which are about to be removed.
+ * \remarks The pending dirs are ordered by their index so the affected rows are contiguous.
+ */
+void SyncthingDownloadModel::handleDirsAboutToBeRemoved(int first, int last)
+{
+    const auto firstIndex = static_cast<std::size_t>(first), lastIndex = static_cast<std::size_t>(last);
+    const auto begin
+        = std::find_if(m_pendingDirs.begin(), m_pendingDirs.end(), [firstIndex](const PendingDir &dir) { return dir.dirIndex >= firstIndex; });
+    const auto end = std::find_if(begin, m_pendingDirs.end(), [lastIndex](const PendingDir &dir) { return dir.dirIndex > lastIndex; });
+    if (begin == end) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), static_cast<int>(begin - m_pendingDirs.begin()), static_cast<int>(end - m_pendingDirs.begin() - 1));
+    m_pendingDirs.erase(begin, end);
+    endRemoveRows();
+}
+
+/*!
+ * \brief Shifts the indexes of pending dirs after the removed dirs.
+ */
+void SyncthingDownloadModel::handleDirsRemoved(int first, int last)
+{
+    const auto count = static_cast<std::size_t>(last - first + 1);
+    for (auto &pendingDir : m_pendingDirs) {
+        if (pendingDir.dirIndex > static_cast<std::size_t>(last)) {
+            pendingDir.dirIndex -= count;
+        }
+    }
+}
+
 void SyncthingDownloadModel::handleNewConfigAvailable()
 {
     m_pendingDirs.reserve(m_connection.dirInfo().size());
@@ -232,10 +307,11 @@ void SyncthingDownloadModel::handleNewConfigAvailable()
 void SyncthingDownloadModel::downloadProgressChanged()
 {
     int row = 0;
+    std::size_t dirIndex = 0;
     // iterate through all directories ...
     for (const SyncthingDir &dirInfo : m_connection.dirInfo()) {
         // ... and check whether the directory has been pending before
-        const auto pendingIterator = find(m_pendingDirs.begin(), m_pendingDirs.end(), &dirInfo);
+        const auto pendingIterator = find(m_pendingDirs.begin(), m_pendingDirs.end(), dirIndex++);
 
         // check whether the directory has downloading items ("is pending")
         if (dirInfo.downloadingItems.empty()) {
@@ -276,12 +352,13 @@ void SyncthingDownloadModel::downloadProgressChanged()
 
             } else {
                 // add the new directory
+                // note: Inserting at the row (and not just appending) keeps the pending dirs ordered by their index.
                 beginInsertRows(QModelIndex(), row, row);
-                m_pendingDirs.emplace_back(&dirInfo, 0);
+                const auto pendingDir = m_pendingDirs.emplace(m_pendingDirs.begin() + row, dirIndex - 1, 0);
                 endInsertRows();
                 // add new pending items
                 beginInsertRows(index(row, row), 0, static_cast<int>(dirInfo.downloadingItems.size() - 1));
-                m_pendingDirs.back().pendingItems = dirInfo.downloadingItems.size();
+                pendingDir->pendingItems = dirInfo.downloadingItems.size();
                 endInsertRows();
             }
             ++row;
@@ -289,6 +366,88 @@ void SyncthingDownloadModel::downloadProgressChanged()
     }
 }
 
+/*!
+ * \brief Returns the icon for the file type of the specified \a progress.
+ * \remarks
+ * - Icons are cached by file suffix so repainting does not cause any file system access.
+ * - Files without suffix (e.g. "Makefile") are cached by their name instead so they do not all share the icon of the
+ *   first such file. The name is prefixed with a slash so it never clashes with a suffix. Their MIME type is only
+ *   determined by resolvePendingFileIcons() so no MIME lookup happens here.
+ * - The icon for a key not seen before is resolved asynchronously; until then the generic icon is returned and the
+ *   decoration of the affected items is updated once the icon is available.
+ */
+const QIcon &SyncthingDownloadModel::fileIcon(const SyncthingItemDownloadProgress &progress) const
+{
+    auto key = progress.fileInfo.suffix().toLower();
+    if (key.isEmpty()) {
+        key = QChar('/') + progress.fileInfo.fileName();
+    }
+    if (const auto icon = m_fileIcons.constFind(key); icon != m_fileIcons.cend()) {
+        return *icon;
+    }
+    m_pendingFileIcons.insert(key, progress.fileInfo.fileName());
+    if (!m_fileIconTimer.isActive()) {
+        m_fileIconTimer.start();
+    }
+    return *m_fileIcons.insert(key, m_unknownIcon);
+}
+
+/*!
+ * \brief Determines the icon names for the pending file types in a separate thread.
+ * \remarks The MIME type is only matched by the file name so the files themselves are not accessed.
+ */
+void SyncthingDownloadModel::resolvePendingFileIcons()
+{
+    if (m_pendingFileIcons.isEmpty() || m_fileIconWatcher.isRunning()) {
+        return;
+    }
+    m_fileIconWatcher.setFuture(QtConcurrent::run([fileNamesByKey = std::exchange(m_pendingFileIcons, QHash<QString, QString>())] {
+        const auto mimeDatabase = QMimeDatabase();
+        auto iconNames = FileIconNamesByKey();
+        iconNames.reserve(fileNamesByKey.size());
+        for (auto i = fileNamesByKey.cbegin(), end = fileNamesByKey.cend(); i != end; ++i) {
+            const auto mimeType = mimeDatabase.mimeTypeForFile(i.value(), QMimeDatabase::MatchExtension);
+            iconNames.insert(i.key(), FileIconNames{ mimeType.iconName(), mimeType.genericIconName(), i.value() });
+        }
+        return iconNames;
+    }));
+}
+
+/*!
+ * \brief Caches the icons determined by resolvePendingFileIcons() and updates the decoration of all items.
+ * \remarks
+ * - Icon themes are usually only available under Linux and BSD so the icon of the platform's file icon provider is used
+ *   as fallback (e.g. under Windows and macOS) if the theme has no icon for the MIME type. The icon provider is only
+ *   queried by the file name so the file itself is not accessed.
+ * - This function is invoked in the GUI thread so using QFileIconProvider is fine.
+ */
+void SyncthingDownloadModel::handleFileIconsResolved()
+{
+    const auto iconNames = m_fileIconWatcher.result();
+    auto iconProvider = std::unique_ptr<QFileIconProvider>();
+    for (auto i = iconNames.cbegin(), end = iconNames.cend(); i != end; ++i) {
+        auto icon = QIcon::fromTheme(i.value().iconName);
+        if (icon.isNull()) {
+            icon = QIcon::fromTheme(i.value().genericIconName);
+        }
+        if (icon.isNull()) {
+            if (!iconProvider) {
+                iconProvider = std::make_unique<QFileIconProvider>();
+            }
+            icon = iconProvider->icon(QFileInfo(i.value().fileName));
+        }
+        m_fileIcons.insert(i.key(), icon.isNull() ? m_unknownIcon : icon);
+    }
+    static const QVector<int> roles({ Qt::DecorationRole });
+    for (auto row = 0, rows = static_cast<int>(m_pendingDirs.size()); row != rows; ++row) {
+        if (const auto pendingItems = static_cast<int>(m_pendingDirs[static_cast<std::size_t>(row)].pendingItems)) {
+            const auto parentIndex = index(row, 0);
+            emit dataChanged(index(0, 0, parentIndex), index(pendingItems - 1, 0, parentIndex), roles);
+        }
+    }
+    resolvePendingFileIcons();
+}
+
 void SyncthingDownloadModel::setSingleColumnMode(bool singleColumnModeEnabled)
 {
     if (m_singleColumnMode != singleColumnModeEnabled) {
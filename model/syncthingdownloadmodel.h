@@ -3,9 +3,12 @@
 
 #include "./syncthingmodel.h"
 
-#include <QFileIconProvider>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QIcon>
+#include <QTimer>
 
+#include <utility>
 #include <vector>
 
 namespace Data {
@@ -44,20 +47,39 @@ Q_SIGNALS:
 private Q_SLOTS:
     void handleConfigInvalidated() override;
     void handleNewConfigAvailable() override;
+    void resetPendingDirs();
+    void handleDirsInserted(int first, int last);
+    void handleDirsAboutToBeRemoved(int first, int last);
+    void handleDirsRemoved(int first, int last);
     void downloadProgressChanged();
+    void resolvePendingFileIcons();
+    void handleFileIconsResolved();
 
 private:
+    struct FileIconNames {
+        QString iconName;
+        QString genericIconName;
+        QString fileName;
+    };
+    using FileIconNamesByKey = QHash<QString, FileIconNames>;
+
+    const QIcon &fileIcon(const SyncthingItemDownloadProgress &progress) const;
+    const SyncthingDir &pendingDirInfo(std::size_t row) const;
+
     struct PendingDir {
-        const SyncthingDir *syncthingDir;
+        std::size_t dirIndex;
         std::size_t pendingItems;
 
-        PendingDir(const SyncthingDir *syncthingDir, unsigned int pendingItems);
-        bool operator==(const SyncthingDir *dir) const;
+        PendingDir(std::size_t dirIndex, unsigned int pendingItems);
+        bool operator==(std::size_t index) const;
     };
 
     const std::vector<SyncthingDir> &m_dirs;
     const QIcon m_unknownIcon;
-    const QFileIconProvider m_fileIconProvider;
+    mutable QHash<QString, QIcon> m_fileIcons;
+    mutable QHash<QString, QString> m_pendingFileIcons;
+    mutable QTimer m_fileIconTimer;
+    QFutureWatcher<FileIconNamesByKey> m_fileIconWatcher;
     std::vector<PendingDir> m_pendingDirs;
     unsigned int m_pendingDownloads;
     bool m_singleColumnMode;
@@ -1,13 +1,32 @@
 #include "./syncthingicons.h"
 
+#include "resources/config.h"
+
 #include <qtutilities/misc/compat.h>
 
+#include <c++utilities/io/ansiescapecodes.h>
+
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
-#include <QGuiApplication>
+#include <QFileInfo>
+#include <QIconEngine>
 #include <QPainter>
+#include <QPixmapCache>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QStringBuilder>
+#include <QStyle>
+#include <QStyleOption>
 #include <QSvgRenderer>
 
+#include <iostream>
+#include <memory>
+
+using namespace CppUtilities::EscapeCodes;
+
 namespace Data {
 
 /*!
@@ -115,14 +134,17 @@ QByteArray makeSyncthingIcon(const StatusIconColorSet &colors, StatusEmblem stat
 
 /// \cond
 namespace Detail {
-template <typename SourceType> QPixmap renderSvgImage(const SourceType &source, const QSize &givenSize, int margin)
+static qreal renderScaleFactor()
 {
-    const auto scaleFactor =
+    return
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
         !QCoreApplication::testAttribute(Qt::AA_UseHighDpiPixmaps) ? 1.0 :
 #endif
                                                                    qGuiApp->devicePixelRatio();
-    const auto scaledSize = QSize(givenSize * scaleFactor);
+}
+
+template <typename SourceType> QPixmap renderSvgImage(const SourceType &source, const QSize &scaledSize, int margin, qreal scaleFactor)
+{
     auto renderer = QSvgRenderer(source);
     auto renderSize = QSize(renderer.defaultSize());
     renderSize.scale(scaledSize.width() - margin, scaledSize.height() - margin, Qt::KeepAspectRatio);
@@ -144,6 +166,254 @@ template <typename SourceType> QPixmap renderSvgImage(const SourceType &source,
     pm.setDevicePixelRatio(scaleFactor);
     return pm;
 }
+
+template <typename SourceType> QPixmap renderSvgImage(const SourceType &source, const QSize &givenSize, int margin)
+{
+    const auto scaleFactor = renderScaleFactor();
+    return renderSvgImage(source, QSize(givenSize * scaleFactor), margin, scaleFactor);
+}
+
+static bool logIconRendering()
+{
+    static const auto enabled = qEnvironmentVariableIntValue(PROJECT_VARNAME_UPPER "_LOG_ICON_RENDERING") != 0;
+    return enabled;
+}
+
+/*!
+ * \brief Prunes the persistent icon cache within \a dir; called once per process by iconCacheDirectory().
+ * \remarks
+ * - The whole directory is wiped if it has been populated by another version (which might render icons differently). The
+ *   version is stamped into the file "version" within the directory. Bump iconCacheFormat to invalidate caches of
+ *   development builds.
+ * - Otherwise the oldest icons are evicted if there are more than maxCachedIcons (icons rendered for previous color
+ *   settings are not used anymore).
+ */
+static void pruneIconCache(const QString &dir)
+{
+    static constexpr auto iconCacheFormat = 1;
+    static constexpr auto maxCachedIcons = 1000;
+    const auto versionStamp = QByteArray(APP_VERSION "-" + QByteArray::number(iconCacheFormat));
+    auto versionFile = QFile(dir + QStringLiteral("/version"));
+    if (!versionFile.open(QFile::ReadOnly) || versionFile.readAll() != versionStamp) {
+        versionFile.close();
+        QDir(dir).removeRecursively();
+        if (QDir().mkpath(dir) && versionFile.open(QFile::WriteOnly | QFile::Truncate)) {
+            versionFile.write(versionStamp);
+        }
+        return;
+    }
+    const auto icons = QDir(dir).entryInfoList(QStringList(QStringLiteral("*.png")), QDir::Files, QDir::Time | QDir::Reversed);
+    for (auto i = 0, excess = static_cast<int>(icons.size()) - maxCachedIcons; i < excess; ++i) {
+        QFile::remove(icons.at(i).absoluteFilePath());
+    }
+}
+
+/*!
+ * \brief Returns the directory used to persist rendered icons across application starts.
+ * \remarks The directory is shared between the tray application, the Plasmoid and the file item action plugin.
+ */
+static const QString &iconCacheDirectory()
+{
+    static const auto dir = [] {
+        if (qEnvironmentVariableIntValue(PROJECT_VARNAME_UPPER "_DISABLE_ICON_CACHE")) {
+            return QString();
+        }
+        const auto cacheLocation = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (cacheLocation.isEmpty()) {
+            return QString();
+        }
+        auto iconCacheLocation = QString(cacheLocation + QStringLiteral("/syncthingtray/icons"));
+        pruneIconCache(iconCacheLocation);
+        return iconCacheLocation;
+    }();
+    return dir;
+}
+
+/*!
+ * \brief The SvgIconSource struct holds the SVG document an icon is rendered from.
+ */
+struct SvgIconSource {
+    explicit SvgIconSource(QByteArray &&contents, const QSize &defaultSize, int margin);
+    const QByteArray &id();
+
+    QByteArray contents;
+    QByteArray contentsHash;
+    QSize defaultSize;
+    int margin;
+};
+
+SvgIconSource::SvgIconSource(QByteArray &&contents, const QSize &defaultSize, int margin)
+    : contents(std::move(contents))
+    , defaultSize(defaultSize)
+    , margin(margin)
+{
+}
+
+/*!
+ * \brief Returns an identifier for the icon which changes whenever the SVG document (including its colors) changes.
+ * \remarks The hash is computed on first use so creating an icon remains cheap.
+ */
+const QByteArray &SvgIconSource::id()
+{
+    if (contentsHash.isEmpty()) {
+        contentsHash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1).toHex();
+    }
+    return contentsHash;
+}
+
+/*!
+ * \brief The SvgIconEngine class renders an SVG icon lazily when a pixmap of a certain size is requested for the first time.
+ * \remarks
+ * - Rendered pixmaps are kept in the QPixmapCache and persisted as PNG files within iconCacheDirectory() so the SVG
+ *   rasterization can be skipped completely on subsequent application starts.
+ * - The cache key consists of the hash of the SVG document (which covers the color set), the size in device pixels,
+ *   the device pixel ratio and the margin.
+ * - The default size and margin are those the icon has previously been rendered with eagerly. The margin is scaled
+ *   proportionally when rendering at different sizes so icons look the same as before.
+ */
+class SvgIconEngine : public QIconEngine {
+public:
+    explicit SvgIconEngine(QByteArray &&contents, const QSize &defaultSize, int margin = 0);
+
+    void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) override;
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override;
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+    QPixmap scaledPixmap(const QSize &size, QIcon::Mode mode, QIcon::State state, qreal scale) override;
+    QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) override;
+#else
+    void virtual_hook(int id, void *data) override;
+#endif
+    QString key() const override;
+    QIconEngine *clone() const override;
+
+private:
+    QPixmap render(const QSize &scaledSize, qreal scaleFactor, QIcon::Mode mode);
+    QList<QSize> defaultSizes() const;
+
+    std::shared_ptr<SvgIconSource> m_source;
+};
+
+SvgIconEngine::SvgIconEngine(QByteArray &&contents, const QSize &defaultSize, int margin)
+    : m_source(std::make_shared<SvgIconSource>(std::move(contents), defaultSize, margin))
+{
+}
+
+void SvgIconEngine::paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state)
+{
+    Q_UNUSED(state)
+    const auto scaleFactor = painter->device()->devicePixelRatioF();
+    painter->drawPixmap(rect, render(QSize(rect.size() * scaleFactor), scaleFactor, mode));
+}
+
+QPixmap SvgIconEngine::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
+{
+    Q_UNUSED(state)
+    return render(size, 1.0, mode);
+}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+QPixmap SvgIconEngine::scaledPixmap(const QSize &size, QIcon::Mode mode, QIcon::State state, qreal scale)
+{
+    Q_UNUSED(state)
+    return render(QSize(size * scale), scale, mode);
+}
+
+QList<QSize> SvgIconEngine::availableSizes(QIcon::Mode mode, QIcon::State state)
+{
+    Q_UNUSED(mode)
+    Q_UNUSED(state)
+    return defaultSizes();
+}
+#else
+void SvgIconEngine::virtual_hook(int id, void *data)
+{
+    switch (id) {
+    case QIconEngine::AvailableSizesHook:
+        reinterpret_cast<QIconEngine::AvailableSizesArgument *>(data)->sizes = defaultSizes();
+        break;
+    default:
+        QIconEngine::virtual_hook(id, data);
+    }
+}
+#endif
+
+QString SvgIconEngine::key() const
+{
+    return QStringLiteral("SvgIconEngine");
+}
+
+QIconEngine *SvgIconEngine::clone() const
+{
+    return new SvgIconEngine(*this);
+}
+
+/*!
+ * \brief Returns the size the icon would have been rendered with eagerly (so e.g. the tray picks the same size as before).
+ */
+QList<QSize> SvgIconEngine::defaultSizes() const
+{
+    return QList<QSize>({ QSize(m_source->defaultSize * renderScaleFactor()) });
+}
+
+QPixmap SvgIconEngine::render(const QSize &scaledSize, qreal scaleFactor, QIcon::Mode mode)
+{
+    if (scaledSize.isEmpty()) {
+        return QPixmap();
+    }
+
+    // scale the margin in accordance with the size the icon has been rendered with eagerly
+    auto &source = *m_source;
+    const auto defaultWidth = source.defaultSize.width() * renderScaleFactor();
+    const auto margin = source.margin && defaultWidth > 0 ? qRound(source.margin * scaledSize.width() / defaultWidth) : 0;
+
+    // lookup the pixmap from the in-memory and persistent caches
+    const auto cacheKey = QString(QString::fromLatin1(source.id()) % QChar('-') % QString::number(scaledSize.width()) % QChar('x')
+        % QString::number(scaledSize.height()) % QChar('@') % QString::number(scaleFactor) % QChar('-') % QString::number(margin));
+    auto pm = QPixmap();
+    if (!QPixmapCache::find(cacheKey, &pm)) {
+        auto timer = QElapsedTimer();
+        if (logIconRendering()) {
+            timer.start();
+        }
+        const auto &cacheDir = iconCacheDirectory();
+        const auto cacheFile = cacheDir.isEmpty() ? QString() : QString(cacheDir % QChar('/') % cacheKey % QStringLiteral(".png"));
+        const auto fromDisk = !cacheFile.isEmpty() && pm.load(cacheFile, "PNG") && pm.size() == scaledSize;
+        if (fromDisk) {
+            pm.setDevicePixelRatio(scaleFactor);
+        } else {
+            pm = renderSvgImage(source.contents, scaledSize, margin, scaleFactor);
+            if (!cacheFile.isEmpty() && QDir().mkpath(cacheDir)) {
+                auto file = QSaveFile(cacheFile);
+                if (file.open(QIODevice::WriteOnly) && pm.save(&file, "PNG")) {
+                    file.commit();
+                }
+            }
+        }
+        QPixmapCache::insert(cacheKey, pm);
+        if (logIconRendering()) {
+            std::cerr << Phrases::Info << (fromDisk ? "Loaded icon " : "Rendered icon ") << cacheKey.toStdString() << " in "
+                      << timer.nsecsElapsed() / 1000 << " us" << Phrases::End;
+        }
+    }
+
+    // apply the style's effect for the disabled/active/selected mode like QIcon does for pixmap-based icons
+    if (mode != QIcon::Normal) {
+        if (const auto *const app = qobject_cast<QApplication *>(QCoreApplication::instance())) {
+            auto opt = QStyleOption(0);
+            opt.palette = QGuiApplication::palette();
+            return app->style()->generatedIconPixmap(mode, pm, &opt);
+        }
+    }
+    return pm;
+}
+
+/*!
+ * \brief Returns an icon for the specified SVG document which is only rendered when it is used.
+ */
+static QIcon makeSvgIcon(QByteArray &&contents, const QSize &size, int margin = 0)
+{
+    return QIcon(new SvgIconEngine(std::move(contents), size, margin));
+}
 } // namespace Detail
 /// \endcond
 
@@ -272,43 +542,51 @@ QString StatusIconSettings::toString() const
 }
 
 StatusIcons::StatusIcons(const StatusIconSettings &settings)
-    : disconnected(QIcon(renderSvgImage(makeSyncthingIcon(settings.disconnectedColor, StatusEmblem::None), settings.renderSize)))
-    , idling(QIcon(renderSvgImage(makeSyncthingIcon(settings.idleColor, StatusEmblem::None), settings.renderSize)))
-    , scanninig(QIcon(renderSvgImage(makeSyncthingIcon(settings.scanningColor, StatusEmblem::Scanning), settings.renderSize)))
-    , notify(QIcon(renderSvgImage(makeSyncthingIcon(settings.warningColor, StatusEmblem::Alert), settings.renderSize)))
-    , pause(QIcon(renderSvgImage(makeSyncthingIcon(settings.pausedColor, StatusEmblem::Paused), settings.renderSize)))
-    , sync(QIcon(renderSvgImage(makeSyncthingIcon(settings.synchronizingColor, StatusEmblem::Synchronizing), settings.renderSize)))
-    , syncComplete(QIcon(renderSvgImage(makeSyncthingIcon(settings.defaultColor, StatusEmblem::Complete), settings.renderSize)))
-    , error(QIcon(renderSvgImage(makeSyncthingIcon(settings.errorColor, StatusEmblem::Alert), settings.renderSize)))
-    , errorSync(QIcon(renderSvgImage(makeSyncthingIcon(settings.errorColor, StatusEmblem::Synchronizing), settings.renderSize)))
-    , newItem(QIcon(renderSvgImage(makeSyncthingIcon(settings.defaultColor, StatusEmblem::Add), settings.renderSize)))
+    : disconnected(Detail::makeSvgIcon(makeSyncthingIcon(settings.disconnectedColor, StatusEmblem::None), settings.renderSize))
+    , idling(Detail::makeSvgIcon(makeSyncthingIcon(settings.idleColor, StatusEmblem::None), settings.renderSize))
+    , scanninig(Detail::makeSvgIcon(makeSyncthingIcon(settings.scanningColor, StatusEmblem::Scanning), settings.renderSize))
+    , notify(Detail::makeSvgIcon(makeSyncthingIcon(settings.warningColor, StatusEmblem::Alert), settings.renderSize))
+    , pause(Detail::makeSvgIcon(makeSyncthingIcon(settings.pausedColor, StatusEmblem::Paused), settings.renderSize))
+    , sync(Detail::makeSvgIcon(makeSyncthingIcon(settings.synchronizingColor, StatusEmblem::Synchronizing), settings.renderSize))
+    , syncComplete(Detail::makeSvgIcon(makeSyncthingIcon(settings.defaultColor, StatusEmblem::Complete), settings.renderSize))
+    , error(Detail::makeSvgIcon(makeSyncthingIcon(settings.errorColor, StatusEmblem::Alert), settings.renderSize))
+    , errorSync(Detail::makeSvgIcon(makeSyncthingIcon(settings.errorColor, StatusEmblem::Synchronizing), settings.renderSize))
+    , newItem(Detail::makeSvgIcon(makeSyncthingIcon(settings.defaultColor, StatusEmblem::Add), settings.renderSize))
     , isValid(true)
 {
 }
 
 FontAwesomeIcons::FontAwesomeIcons(const QColor &color, const QSize &size, int margin)
-    : hashtag(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("hashtag"), color), size, margin))
-    , folderOpen(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("folder-open"), color), size, margin))
-    , globe(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("globe"), color), size, margin))
-    , home(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("home"), color), size, margin))
-    , shareAlt(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("share-alt"), color), size, margin))
-    , refresh(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("redo"), color), size, margin))
-    , clock(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("clock"), color), size, margin))
-    , exchangeAlt(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("exchange-alt"), color), size, margin))
-    , exclamationTriangle(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("exclamation-triangle"), color), size, margin))
-    , cogs(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("cogs"), color), size, margin))
-    , link(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("link"), color), size, margin))
-    , eye(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("eye"), color), size, margin))
-    , fileArchive(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("file-archive"), color), size, margin))
-    , folder(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("folder"), color), size, margin))
-    , certificate(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("certificate"), color), size, margin))
-    , networkWired(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("network-wired"), color), size, margin))
-    , cloudDownloadAlt(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("cloud-download-alt"), color), size, margin))
-    , cloudUploadAlt(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("cloud-upload-alt"), color), size, margin))
-    , tag(renderSvgImage(loadFontAwesomeIcon(QStringLiteral("tag"), color), size, margin))
+    : hashtag(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("hashtag"), color), size, margin))
+    , folderOpen(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("folder-open"), color), size, margin))
+    , globe(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("globe"), color), size, margin))
+    , home(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("home"), color), size, margin))
+    , shareAlt(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("share-alt"), color), size, margin))
+    , refresh(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("redo"), color), size, margin))
+    , clock(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("clock"), color), size, margin))
+    , exchangeAlt(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("exchange-alt"), color), size, margin))
+    , exclamationTriangle(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("exclamation-triangle"), color), size, margin))
+    , cogs(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("cogs"), color), size, margin))
+    , link(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("link"), color), size, margin))
+    , eye(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("eye"), color), size, margin))
+    , fileArchive(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("file-archive"), color), size, margin))
+    , folder(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("folder"), color), size, margin))
+    , certificate(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("certificate"), color), size, margin))
+    , networkWired(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("network-wired"), color), size, margin))
+    , cloudDownloadAlt(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("cloud-download-alt"), color), size, margin))
+    , cloudUploadAlt(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("cloud-upload-alt"), color), size, margin))
+    , tag(Detail::makeSvgIcon(loadFontAwesomeIcon(QStringLiteral("tag"), color), size, margin))
 {
 }
 
+/*!
+ * \brief Initializes the icon manager.
+ * \remarks
+ * - Icons are not rendered here but only when they are used for the first time. Set the environment variable
+ *   LIB_SYNCTHING_MODEL_LOG_ICON_RENDERING to log the time spent on initializing/rendering and whether icons
+ *   have been loaded from the persistent cache.
+ * - Set the environment variable LIB_SYNCTHING_MODEL_DISABLE_ICON_CACHE to disable the persistent cache.
+ */
 IconManager::IconManager()
     : m_statusIcons()
     , m_trayIcons(m_statusIcons)
@@ -317,9 +595,18 @@ IconManager::IconManager()
 {
 }
 
+/*!
+ * \brief Returns the icon manager instance, creating it on first use.
+ */
 IconManager &IconManager::instance()
 {
+    // measure the initialization (only the first call starts the timer)
+    auto timer = QElapsedTimer();
+    static const auto logInitialization = Detail::logIconRendering() && (timer.start(), true);
     static IconManager iconManager;
+    if (logInitialization && timer.isValid()) {
+        std::cerr << Phrases::Info << "Icon manager ready after " << timer.nsecsElapsed() / 1000 << " us" << Phrases::End;
+    }
     return iconManager;
 }
 
@@ -49,12 +49,17 @@ void SyncthingModel::setBrightColors(bool brightColors)
 
 void SyncthingModel::handleConfigInvalidated()
 {
-    beginResetModel();
+    // skip resetting if dirs/devs are only updated in place (insertions/removals are handled by the particular models)
+    if (m_connection.isResettingDirsAndDevs()) {
+        beginResetModel();
+    }
 }
 
 void SyncthingModel::handleNewConfigAvailable()
 {
-    endResetModel();
+    if (m_connection.isResettingDirsAndDevs()) {
+        endResetModel();
+    }
 }
 
 void SyncthingModel::handleStatusIconsChanged()
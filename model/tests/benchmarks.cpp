@@ -0,0 +1,207 @@
+#include "../syncthingicons.h"
+
+#include <c++utilities/io/ansiescapecodes.h>
+
+#include <QDir>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPixmapCache>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Data;
+using namespace CppUtilities;
+using namespace CppUtilities::EscapeCodes;
+
+/// \cond
+
+/*!
+ * \brief The BenchmarkResult struct holds the figures measured for one step and cache state.
+ */
+struct BenchmarkResult {
+    std::string step;
+    std::string cache;
+    int iterations = 0;
+    std::int64_t minNanoseconds = 0;
+    std::int64_t medianNanoseconds = 0;
+    std::int64_t meanNanoseconds = 0;
+};
+
+/*!
+ * \brief The IconSets struct holds the icons IconManager::instance() creates when the status icon settings are applied.
+ * \remarks IconManager itself is a singleton so its members are instantiated in the same way here to be able to measure
+ *          the construction repeatedly.
+ */
+struct IconSets {
+    IconSets();
+
+    StatusIcons statusIcons;
+    StatusIcons trayIcons;
+    FontAwesomeIcons fontAwesomeIconsForLightTheme;
+    FontAwesomeIcons fontAwesomeIconsForDarkTheme;
+};
+
+IconSets::IconSets()
+    : statusIcons(StatusIconSettings())
+    , trayIcons(statusIcons)
+    , fontAwesomeIconsForLightTheme(QColor(10, 10, 10), QSize(64, 64), 8)
+    , fontAwesomeIconsForDarkTheme(Qt::white, QSize(64, 64), 8)
+{
+}
+
+/*!
+ * \brief Returns pixmaps for all status icons and the Font Awesome icons of the light theme as the first paint would.
+ * \remarks The size corresponds to the size of the tray icon and icons within the tray menu on a typical screen.
+ */
+static std::size_t paintIcons(const IconSets &icons)
+{
+    static constexpr auto size = QSize(32, 32);
+    const auto &s = icons.statusIcons;
+    const auto &fa = icons.fontAwesomeIconsForLightTheme;
+    auto pixels = std::size_t();
+    for (const auto *const icon : { &s.disconnected, &s.idling, &s.scanninig, &s.notify, &s.pause, &s.sync, &s.syncComplete, &s.error,
+             &s.errorSync, &s.newItem, &fa.hashtag, &fa.folderOpen, &fa.globe, &fa.home, &fa.shareAlt, &fa.refresh, &fa.clock, &fa.exchangeAlt,
+             &fa.exclamationTriangle, &fa.cogs, &fa.link, &fa.eye, &fa.fileArchive, &fa.folder, &fa.certificate, &fa.networkWired,
+             &fa.cloudDownloadAlt, &fa.cloudUploadAlt, &fa.tag }) {
+        const auto pixmap = icon->pixmap(size);
+        pixels += static_cast<std::size_t>(pixmap.width() * pixmap.height());
+    }
+    return pixels;
+}
+
+/*!
+ * \brief Returns the directory the icons are persisted in; see iconCacheDirectory() in syncthingicons.cpp.
+ */
+static QString iconCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/syncthingtray/icons");
+}
+
+/*!
+ * \brief Removes all icons from the persistent cache (but keeps the version stamp).
+ */
+static void clearPersistentIconCache()
+{
+    auto dir = QDir(iconCacheDirectory());
+    for (const auto &icon : dir.entryList(QStringList(QStringLiteral("*.png")), QDir::Files)) {
+        dir.remove(icon);
+    }
+}
+
+/*!
+ * \brief Returns the result for \a step with the specified \a times.
+ */
+static BenchmarkResult makeResult(const char *step, const char *cache, std::vector<std::int64_t> &times)
+{
+    auto result = BenchmarkResult();
+    std::sort(times.begin(), times.end());
+    auto total = std::int64_t();
+    for (const auto time : times) {
+        total += time;
+    }
+    result.step = step;
+    result.cache = cache;
+    result.iterations = static_cast<int>(times.size());
+    result.minNanoseconds = times.front();
+    result.medianNanoseconds = times[times.size() / 2];
+    result.meanNanoseconds = total / static_cast<std::int64_t>(times.size());
+    cerr << Phrases::Info << step << " with " << cache << " cache: " << result.medianNanoseconds / 1000 << " us (median)" << Phrases::End;
+    return result;
+}
+
+/*!
+ * \brief Measures the construction of the icons and the first paint \a iterations times with a cold or warm cache.
+ * \remarks
+ * - With a cold cache, the in-memory and the persistent caches are cleared before each iteration so all icons are rendered.
+ * - With a warm cache, only the in-memory cache is cleared before each iteration so all icons are loaded from disk as on
+ *   subsequent application starts.
+ */
+static void measure(int iterations, bool cold, std::vector<BenchmarkResult> &results)
+{
+    const auto *const cache = cold ? "cold" : "warm";
+    auto constructionTimes = std::vector<std::int64_t>(), paintTimes = std::vector<std::int64_t>();
+    constructionTimes.reserve(static_cast<std::size_t>(iterations));
+    paintTimes.reserve(static_cast<std::size_t>(iterations));
+    if (!cold) {
+        paintIcons(IconSets()); // populate the persistent cache
+    }
+    for (auto i = 0; i != iterations; ++i) {
+        QPixmapCache::clear();
+        if (cold) {
+            clearPersistentIconCache();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const auto icons = IconSets();
+        const auto constructed = std::chrono::steady_clock::now();
+        const auto pixels = paintIcons(icons);
+        const auto painted = std::chrono::steady_clock::now();
+        if (!pixels) {
+            cerr << Phrases::Warning << "Icons could not be rendered." << Phrases::End;
+        }
+        constructionTimes.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(constructed - start).count());
+        paintTimes.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(painted - constructed).count());
+    }
+    results.emplace_back(makeResult("construction", cache, constructionTimes));
+    results.emplace_back(makeResult("firstPaint", cache, paintTimes));
+}
+
+/*!
+ * \brief Returns the results as JSON document.
+ */
+static QByteArray resultsToJson(const std::vector<BenchmarkResult> &results)
+{
+    auto array = QJsonArray();
+    for (const auto &result : results) {
+        array.append(QJsonObject({
+            { QStringLiteral("step"), QString::fromStdString(result.step) },
+            { QStringLiteral("cache"), QString::fromStdString(result.cache) },
+            { QStringLiteral("iterations"), result.iterations },
+            { QStringLiteral("minNs"), static_cast<double>(result.minNanoseconds) },
+            { QStringLiteral("medianNs"), static_cast<double>(result.medianNanoseconds) },
+            { QStringLiteral("meanNs"), static_cast<double>(result.meanNanoseconds) },
+        }));
+    }
+    return QJsonDocument(QJsonObject({ { QStringLiteral("benchmarks"), array } })).toJson(QJsonDocument::Indented);
+}
+
+/// \endcond
+
+/*!
+ * \brief Runs the icon benchmarks and prints the results as JSON to stdout.
+ * \remarks
+ * - The number of iterations can be specified via SYNCTHING_BENCHMARK_ITERATIONS (defaults to 5).
+ * - The test mode of QStandardPaths is enabled so the persistent cache of the user is not touched.
+ * - The "offscreen" platform is used unless QT_QPA_PLATFORM is set so no display is required.
+ * - Progress is printed to stderr so stdout contains only the JSON document.
+ */
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QStandardPaths::setTestModeEnabled(true);
+    auto app = QGuiApplication(argc, argv);
+
+    auto iterationsOk = false;
+    auto iterations = qEnvironmentVariableIntValue("SYNCTHING_BENCHMARK_ITERATIONS", &iterationsOk);
+    if (!iterationsOk || iterations <= 0) {
+        iterations = 5;
+    }
+
+    auto results = std::vector<BenchmarkResult>();
+    measure(iterations, true, results);
+    measure(iterations, false, results);
+    QDir(iconCacheDirectory()).removeRecursively();
+    cout << resultsToJson(results).data() << flush;
+    return EXIT_SUCCESS;
+}
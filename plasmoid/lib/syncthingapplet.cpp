@@ -64,6 +64,7 @@ SyncthingApplet::SyncthingApplet(QObject *parent, const QVariantList &data)
 #endif
     , m_currentConnectionConfig(-1)
     , m_initialized(false)
+    , m_popupShown(false)
 {
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
     m_notifier.setService(&m_service);
@@ -75,6 +76,9 @@ SyncthingApplet::SyncthingApplet(QObject *parent, const QVariantList &data)
 
 SyncthingApplet::~SyncthingApplet()
 {
+    if (m_popupShown) {
+        m_connection.removeVisibleUserInterface();
+    }
     delete m_settingsDlg;
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
     delete m_webViewDlg;
@@ -211,6 +215,7 @@ void SyncthingApplet::setCurrentConnectionConfigIndex(int index)
     if (index != m_currentConnectionConfig && index >= 0 && static_cast<unsigned>(index) <= settings.connection.secondary.size()) {
         auto &selectedConfig = index == 0 ? settings.connection.primary : settings.connection.secondary[static_cast<unsigned>(index) - 1];
         reconnectRequired = m_connection.applySettings(selectedConfig);
+        m_connection.setSnapshotPath(selectedConfig.defaultSnapshotPath());
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
         if (m_webViewDlg) {
             m_webViewDlg->applySettings(selectedConfig, false);
@@ -242,6 +247,23 @@ bool SyncthingApplet::isStartStopEnabled() const
 #endif
 }
 
+/*!
+ * \brief Sets whether the popup is shown, registering it as visible user interface on the connection accordingly.
+ * \remarks The visibility is only added/removed if it actually changes so the reference count of the connection stays balanced.
+ */
+void SyncthingApplet::setPopupShown(bool popupShown)
+{
+    if (m_popupShown == popupShown) {
+        return;
+    }
+    if ((m_popupShown = popupShown)) {
+        m_connection.addVisibleUserInterface();
+    } else {
+        m_connection.removeVisibleUserInterface();
+    }
+    emit popupShownChanged(popupShown);
+}
+
 bool SyncthingApplet::areNotificationsAvailable() const
 {
     return !m_notifications.empty();
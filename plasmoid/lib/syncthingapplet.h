@@ -63,6 +63,7 @@ class SyncthingApplet : public Plasma::Applet {
             currentConnectionConfigIndexChanged)
     Q_PROPERTY(bool startStopEnabled READ isStartStopEnabled NOTIFY settingsChanged)
     Q_PROPERTY(QSize size READ size WRITE setSize NOTIFY sizeChanged)
+    Q_PROPERTY(bool popupShown READ isPopupShown WRITE setPopupShown NOTIFY popupShownChanged)
     Q_PROPERTY(bool notificationsAvailable READ areNotificationsAvailable NOTIFY notificationsAvailableChanged)
     Q_PROPERTY(bool passive READ isPassive NOTIFY passiveChanged)
     Q_PROPERTY(QList<QtUtilities::ChecklistItem> passiveStates READ passiveStates WRITE setPassiveStates)
@@ -101,6 +102,8 @@ public:
     bool isStartStopEnabled() const;
     QSize size() const;
     void setSize(const QSize &size);
+    bool isPopupShown() const;
+    void setPopupShown(bool popupShown);
     bool areNotificationsAvailable() const;
     bool isPassive() const;
     const QList<QtUtilities::ChecklistItem> &passiveStates() const;
@@ -144,6 +147,7 @@ Q_SIGNALS:
     void settingsChanged();
     void currentConnectionConfigIndexChanged(int index);
     void sizeChanged(const QSize &size);
+    void popupShownChanged(bool popupShown);
     void notificationsAvailableChanged(bool notificationsAvailable);
     void passiveChanged(bool passive);
 
@@ -190,6 +194,7 @@ private:
 #endif
     int m_currentConnectionConfig;
     bool m_initialized;
+    bool m_popupShown;
     QSize m_size;
 };
 
@@ -279,6 +284,14 @@ inline void SyncthingApplet::setSize(const QSize &size)
     }
 }
 
+/*!
+ * \brief Returns whether the popup is shown; the connection polls at the configured intervals while this is the case.
+ */
+inline bool SyncthingApplet::isPopupShown() const
+{
+    return m_popupShown;
+}
+
 inline bool SyncthingApplet::isPassive() const
 {
     return status() == Plasma::Types::PassiveStatus;
@@ -33,6 +33,13 @@ Item {
 
     Plasmoid.hideOnWindowDeactivate: true
 
+    // poll at the configured intervals while the popup is shown
+    Binding {
+        target: plasmoid.nativeInterface
+        property: "popupShown"
+        value: plasmoid.expanded
+    }
+
     function action_showWebUI() {
         plasmoid.nativeInterface.showWebUI()
     }
@@ -42,10 +42,8 @@ TrayIcon::TrayIcon(const QString &connectionConfig, QObject *parent)
     , m_notifyOnSyncthingErrors(Settings::values().notifyOn.syncthingErrors)
     , m_messageClickedAction(TrayIconMessageClickedAction::None)
 {
-    // get widget, connection and notifier
+    // get widget
     const auto &widget(trayMenu().widget());
-    const auto &connection(widget.connection());
-    const auto &notifier(widget.notifier());
 
     // set context menu
 #ifndef SYNCTHINGTRAY_UNIFY_TRAY_MENUS
@@ -58,7 +56,7 @@ TrayIcon::TrayIcon(const QString &connectionConfig, QObject *parent)
     connect(m_contextMenu.addAction(
                 QIcon::fromTheme(QStringLiteral("folder-sync"), QIcon(QStringLiteral(":/icons/hicolor/scalable/actions/folder-sync.svg"))),
                 tr("Rescan all")),
-        &QAction::triggered, &widget.connection(), &SyncthingConnection::rescanAllDirs);
+        &QAction::triggered, this, [this] { trayMenu().widget().connection().rescanAllDirs(); });
     connect(m_contextMenu.addAction(
                 QIcon::fromTheme(QStringLiteral("text-x-generic"), QIcon(QStringLiteral(":/icons/hicolor/scalable/mimetypes/text-x-generic.svg"))),
                 tr("Log")),
@@ -83,6 +81,35 @@ TrayIcon::TrayIcon(const QString &connectionConfig, QObject *parent)
     // connect signals and slots
     connect(this, &TrayIcon::activated, this, &TrayIcon::handleActivated);
     connect(this, &TrayIcon::messageClicked, this, &TrayIcon::handleMessageClicked);
+    connect(&widget, &TrayWidget::connectionChanged, this, &TrayIcon::handleConnectionChanged);
+    connect(&IconManager::instance(), &IconManager::statusIconsChanged, this, &TrayIcon::updateStatusIconAndText);
+#ifdef QT_UTILITIES_SUPPORT_DBUS_NOTIFICATIONS
+    connect(&m_dbusNotifier, &DBusStatusNotifier::connectRequested, this, [this] { trayMenu().widget().connection().connect(); });
+    connect(&m_dbusNotifier, &DBusStatusNotifier::dismissNotificationsRequested, &widget, &TrayWidget::dismissNotifications);
+    connect(&m_dbusNotifier, &DBusStatusNotifier::showNotificationsRequested, &widget, &TrayWidget::showNotifications);
+    connect(&m_dbusNotifier, &DBusStatusNotifier::errorDetailsRequested, this, &TrayIcon::showInternalErrorsDialog);
+    connect(&m_dbusNotifier, &DBusStatusNotifier::webUiRequested, &widget, &TrayWidget::showWebUi);
+#endif
+    handleConnectionChanged(nullptr);
+
+    // apply settings, this also establishes the connection to Syncthing (according to settings)
+    // note: It is important to apply settings only after all Signals & Slots have been connected (e.g. to handle SyncthingConnection::error()).
+    // note: This weirdly calls updateStatusIconAndText(). So there is not need to call it again within this constructor.
+    trayMenu().widget().applySettings(connectionConfig);
+}
+
+/*!
+ * \brief Connects the signals of the connection and notifier of the tray widget.
+ * \remarks Called initially and when the tray widget switched to another (possibly shared) connection. The signals of the
+ *          \a previousConnection are disconnected because it might still be in use by other tray widgets.
+ */
+void TrayIcon::handleConnectionChanged(Data::SyncthingConnection *previousConnection)
+{
+    if (previousConnection) {
+        disconnect(previousConnection, nullptr, this, nullptr);
+    }
+    const auto &connection(trayMenu().widget().connection());
+    const auto &notifier(trayMenu().widget().notifier());
     connect(&connection, &SyncthingConnection::error, this, &TrayIcon::showInternalError);
     connect(&connection, &SyncthingConnection::newNotification, this, &TrayIcon::showSyncthingNotification);
     connect(&notifier, &SyncthingNotifier::syncthingProcessError, this, &TrayIcon::showLauncherError);
@@ -93,21 +120,12 @@ TrayIcon::TrayIcon(const QString &connectionConfig, QObject *parent)
     connect(&connection, &SyncthingConnection::statusChanged, this, &TrayIcon::updateStatusIconAndText);
     connect(&connection, &SyncthingConnection::newDevices, this, &TrayIcon::updateStatusIconAndText);
     connect(&connection, &SyncthingConnection::devStatusChanged, this, &TrayIcon::updateStatusIconAndText);
-    connect(&IconManager::instance(), &IconManager::statusIconsChanged, this, &TrayIcon::updateStatusIconAndText);
 #ifdef QT_UTILITIES_SUPPORT_DBUS_NOTIFICATIONS
-    connect(&m_dbusNotifier, &DBusStatusNotifier::connectRequested, &connection,
-        static_cast<void (SyncthingConnection::*)(void)>(&SyncthingConnection::connect));
-    connect(&m_dbusNotifier, &DBusStatusNotifier::dismissNotificationsRequested, &widget, &TrayWidget::dismissNotifications);
-    connect(&m_dbusNotifier, &DBusStatusNotifier::showNotificationsRequested, &widget, &TrayWidget::showNotifications);
-    connect(&m_dbusNotifier, &DBusStatusNotifier::errorDetailsRequested, this, &TrayIcon::showInternalErrorsDialog);
-    connect(&m_dbusNotifier, &DBusStatusNotifier::webUiRequested, &widget, &TrayWidget::showWebUi);
     connect(&notifier, &SyncthingNotifier::connected, &m_dbusNotifier, &DBusStatusNotifier::hideDisconnect);
 #endif
-
-    // apply settings, this also establishes the connection to Syncthing (according to settings)
-    // note: It is important to apply settings only after all Signals & Slots have been connected (e.g. to handle SyncthingConnection::error()).
-    // note: This weirdly calls updateStatusIconAndText(). So there is not need to call it again within this constructor.
-    trayMenu().widget().applySettings(connectionConfig);
+    if (previousConnection) {
+        updateStatusIconAndText();
+    }
 }
 
 /*!
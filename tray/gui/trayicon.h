@@ -14,6 +14,7 @@ QT_FORWARD_DECLARE_CLASS(QPixmap)
 QT_FORWARD_DECLARE_CLASS(QNetworkRequest)
 
 namespace Data {
+class SyncthingConnection;
 enum class SyncthingStatus;
 enum class SyncthingErrorCategory;
 struct SyncthingDir;
@@ -47,6 +48,7 @@ private Q_SLOTS:
     void showDisconnected();
     void showSyncComplete(const QString &message);
     void handleErrorsCleared();
+    void handleConnectionChanged(Data::SyncthingConnection *previousConnection);
 
 private:
     QWidget m_parentWidget;
@@ -15,6 +15,7 @@
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
 #include <syncthingconnector/syncthingservice.h>
 #endif
+#include <syncthingconnector/syncthingconnectionregistry.h>
 #include <syncthingconnector/utils.h>
 
 // use meta-data of syncthingtray application here
@@ -46,6 +47,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 using namespace CppUtilities;
 using namespace QtUtilities;
@@ -72,15 +74,9 @@ TrayWidget::TrayWidget(TrayMenu *parent)
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
     , m_webViewDlg(nullptr)
 #endif
-    , m_notifier(m_connection)
-    , m_dirModel(m_connection)
-    , m_sortFilterDirModel(&m_dirModel)
-    , m_devModel(m_connection)
-    , m_sortFilterDevModel(&m_devModel)
-    , m_dlModel(m_connection)
-    , m_recentChangesModel(m_connection)
     , m_selectedConnection(nullptr)
     , m_startStopButtonTarget(StartStopButtonTarget::None)
+    , m_visibleOnConnection(false)
 {
     // don't show connection status within connection settings if there are multiple tray widgets/icons (would be ambiguous)
     if (!s_instances.empty() && s_settingsDlg) {
@@ -98,12 +94,12 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     m_ui->setupUi(this);
 
     // setup models and views
+    // note: The connection is replaced by a shared one in applySettings() if another tray widget targets the same Syncthing instance.
+    setConnection(SyncthingConnectionRegistry::instance().create());
     m_ui->dirsTreeView->header()->setSortIndicator(0, Qt::AscendingOrder);
     m_ui->dirsTreeView->setModel(&m_sortFilterDirModel);
     m_ui->devsTreeView->header()->setSortIndicator(0, Qt::AscendingOrder);
     m_ui->devsTreeView->setModel(&m_sortFilterDevModel);
-    m_ui->downloadsTreeView->setModel(&m_dlModel);
-    m_ui->recentChangesTreeView->setModel(&m_recentChangesModel);
     m_ui->recentChangesTreeView->setContextMenuPolicy(Qt::CustomContextMenu);
 
     // setup sync-all button
@@ -181,10 +177,6 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     connect(m_ui->aboutPushButton, &QPushButton::clicked, this, &TrayWidget::showAboutDialog);
     connect(m_ui->webUiPushButton, &QPushButton::clicked, this, &TrayWidget::showWebUi);
     connect(m_ui->settingsPushButton, &QPushButton::clicked, this, &TrayWidget::showSettingsDialog);
-    connect(&m_connection, &SyncthingConnection::statusChanged, this, &TrayWidget::handleStatusChanged);
-    connect(&m_connection, &SyncthingConnection::trafficChanged, this, &TrayWidget::updateTraffic);
-    connect(&m_connection, &SyncthingConnection::dirStatisticsChanged, this, &TrayWidget::updateOverallStatistics);
-    connect(&m_connection, &SyncthingConnection::newNotification, this, &TrayWidget::handleNewNotification);
     connect(m_ui->dirsTreeView, &DirView::openDir, this, &TrayWidget::openDir);
     connect(m_ui->dirsTreeView, &DirView::scanDir, this, &TrayWidget::scanDir);
     connect(m_ui->dirsTreeView, &DirView::pauseResumeDir, this, &TrayWidget::pauseResumeDir);
@@ -192,7 +184,7 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     connect(m_ui->downloadsTreeView, &DownloadView::openDir, this, &TrayWidget::openDir);
     connect(m_ui->downloadsTreeView, &DownloadView::openItemDir, this, &TrayWidget::openItemDir);
     connect(m_ui->recentChangesTreeView, &QTreeView::customContextMenuRequested, this, &TrayWidget::showRecentChangesContextMenu);
-    connect(scanAllButton, &QPushButton::clicked, &m_connection, &SyncthingConnection::rescanAllDirs);
+    connect(scanAllButton, &QPushButton::clicked, this, [this] { m_connection->rescanAllDirs(); });
     connect(viewIdButton, &QPushButton::clicked, this, &TrayWidget::showOwnDeviceId);
     connect(showLogButton, &QPushButton::clicked, this, &TrayWidget::showLog);
     connect(m_ui->notificationsPushButton, &QPushButton::clicked, this, &TrayWidget::showNotifications);
@@ -214,6 +206,7 @@ TrayWidget::TrayWidget(TrayMenu *parent)
 
 TrayWidget::~TrayWidget()
 {
+    setVisibleOnConnection(false);
     auto i = std::find(s_instances.begin(), s_instances.end(), this);
     if (i != s_instances.end()) {
         s_instances.erase(i);
@@ -232,7 +225,7 @@ void TrayWidget::showSettingsDialog()
         s_dialogParent = new QWidget();
     }
     if (!s_settingsDlg) {
-        s_settingsDlg = new SettingsDialog(s_instances.size() < 2 ? &m_connection : nullptr, s_dialogParent);
+        s_settingsDlg = new SettingsDialog(s_instances.size() < 2 ? m_connection.get() : nullptr, s_dialogParent);
         connect(s_settingsDlg, &SettingsDialog::applied, &TrayWidget::applySettingsOnAllInstances);
 
         // save settings to disk when applied
@@ -271,7 +264,7 @@ void TrayWidget::showWebUi()
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
     if (Settings::values().webView.disabled) {
 #endif
-        QDesktopServices::openUrl(m_connection.syncthingUrl());
+        QDesktopServices::openUrl(m_connection->syncthingUrl());
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
     } else {
         if (!m_webViewDlg) {
@@ -288,14 +281,14 @@ void TrayWidget::showWebUi()
 
 void TrayWidget::showOwnDeviceId()
 {
-    auto *const dlg = ownDeviceIdDialog(m_connection);
+    auto *const dlg = ownDeviceIdDialog(*m_connection);
     dlg->setAttribute(Qt::WA_DeleteOnClose, true);
     showDialog(dlg, centerWidgetAvoidingOverflow(dlg));
 }
 
 void TrayWidget::showLog()
 {
-    auto *const dlg = TextViewDialog::forLogEntries(m_connection);
+    auto *const dlg = TextViewDialog::forLogEntries(*m_connection);
     dlg->setAttribute(Qt::WA_DeleteOnClose, true);
     showDialog(dlg, centerWidgetAvoidingOverflow(dlg));
 }
@@ -337,7 +330,7 @@ void TrayWidget::showInternalErrorsDialog()
 
 void TrayWidget::dismissNotifications()
 {
-    m_connection.considerAllNotificationsRead();
+    m_connection->considerAllNotificationsRead();
     m_ui->notificationsPushButton->setHidden(true);
     if (m_menu && m_menu->icon()) {
         m_menu->icon()->updateStatusIconAndText();
@@ -349,7 +342,7 @@ void TrayWidget::restartSyncthing()
     if (QMessageBox::warning(
             this, QCoreApplication::applicationName(), tr("Do you really want to restart Syncthing?"), QMessageBox::Yes, QMessageBox::No)
         == QMessageBox::Yes) {
-        m_connection.restart();
+        m_connection->restart();
     }
 }
 
@@ -368,6 +361,35 @@ void TrayWidget::quitTray()
     parent->deleteLater();
 }
 
+void TrayWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    setVisibleOnConnection(true);
+}
+
+void TrayWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    setVisibleOnConnection(false);
+}
+
+/*!
+ * \brief Registers whether this widget is visible on the connection.
+ * \remarks The connection might be shared with other tray widgets so the visibility is reference-counted by the connection
+ *          and only added/removed here if it actually changes for this widget.
+ */
+void TrayWidget::setVisibleOnConnection(bool visible)
+{
+    if (m_visibleOnConnection == visible || !m_connection) {
+        return;
+    }
+    if ((m_visibleOnConnection = visible)) {
+        m_connection->addVisibleUserInterface();
+    } else {
+        m_connection->removeVisibleUserInterface();
+    }
+}
+
 void TrayWidget::handleStatusChanged(SyncthingStatus status)
 {
     switch (status) {
@@ -451,10 +473,12 @@ void TrayWidget::applySettings(const QString &connectionConfig)
     }
     m_ui->connectionsPushButton->setText(m_selectedConnection->label);
     m_ui->connectionsPushButton->setHidden(secondaryConnectionSettings.empty());
-    const bool reconnectRequired = m_connection.applySettings(*m_selectedConnection);
+    auto reconnectRequired = false;
+    setConnection(SyncthingConnectionRegistry::instance().acquire(*m_selectedConnection, m_connection, reconnectRequired));
+    m_connection->setSnapshotPath(m_selectedConnection->defaultSnapshotPath());
 
     // apply notification settings
-    settings.apply(m_notifier);
+    settings.apply(*m_notifier);
 
     // apply systemd and launcher settings enforcing a reconnect if required and possible
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
@@ -470,7 +494,7 @@ void TrayWidget::applySettings(const QString &connectionConfig)
     m_ui->startStopPushButton->setVisible(showStartStopButton);
     if (reconnectRequired && !systemdOrLauncherRelevantForReconnect) {
         // simply enforce the reconnect for this connection if the systemd or launcher status are relevant for it
-        m_connection.reconnect();
+        m_connection->reconnect();
     }
 
 #ifndef SYNCTHINGWIDGETS_NO_WEBVIEW
@@ -498,10 +522,10 @@ void TrayWidget::applySettings(const QString &connectionConfig)
         m_ui->tabWidget->setTabPosition(static_cast<QTabWidget::TabPosition>(settings.appearance.tabPosition));
     }
     const auto brightColors = settings.appearance.brightTextColors;
-    m_dirModel.setBrightColors(brightColors);
-    m_devModel.setBrightColors(brightColors);
-    m_dlModel.setBrightColors(brightColors);
-    m_recentChangesModel.setBrightColors(brightColors);
+    m_dirModel->setBrightColors(brightColors);
+    m_devModel->setBrightColors(brightColors);
+    m_dlModel->setBrightColors(brightColors);
+    m_recentChangesModel->setBrightColors(brightColors);
     IconManager::instance().applySettings(&settings.icons.status, settings.icons.distinguishTrayIcons ? &settings.icons.tray : nullptr);
     m_ui->webUiPushButton->setIcon(statusIcons().idling);
 
@@ -549,24 +573,24 @@ void TrayWidget::openItemDir(const SyncthingItemDownloadProgress &item)
 
 void TrayWidget::scanDir(const SyncthingDir &dir)
 {
-    m_connection.rescan(dir.id);
+    m_connection->rescan(dir.id);
 }
 
 void TrayWidget::pauseResumeDev(const SyncthingDev &dev)
 {
     if (dev.paused) {
-        m_connection.resumeDevice(QStringList(dev.id));
+        m_connection->resumeDevice(QStringList(dev.id));
     } else {
-        m_connection.pauseDevice(QStringList(dev.id));
+        m_connection->pauseDevice(QStringList(dev.id));
     }
 }
 
 void TrayWidget::pauseResumeDir(const SyncthingDir &dir)
 {
     if (dir.paused) {
-        m_connection.resumeDirectories(QStringList(dir.id));
+        m_connection->resumeDirectories(QStringList(dir.id));
     } else {
-        m_connection.pauseDirectories(QStringList(dir.id));
+        m_connection->pauseDirectories(QStringList(dir.id));
     }
 }
 
@@ -580,7 +604,7 @@ void TrayWidget::showRecentChangesContextMenu(const QPoint &position)
         return [this, role] {
             const auto *const selectionModelToCopy = m_ui->recentChangesTreeView->selectionModel();
             if (selectionModelToCopy && selectionModelToCopy->selectedRows().size() == 1) {
-                QGuiApplication::clipboard()->setText(m_recentChangesModel.data(selectionModelToCopy->selectedRows().at(0), role).toString());
+                QGuiApplication::clipboard()->setText(m_recentChangesModel->data(selectionModelToCopy->selectedRows().at(0), role).toString());
             }
         };
     };
@@ -597,9 +621,9 @@ void TrayWidget::showRecentChangesContextMenu(const QPoint &position)
 
 void TrayWidget::changeStatus()
 {
-    switch (m_connection.status()) {
+    switch (m_connection->status()) {
     case SyncthingStatus::Disconnected:
-        m_connection.connect();
+        m_connection->connect();
         break;
     case SyncthingStatus::Reconnecting:
         break;
@@ -607,10 +631,10 @@ void TrayWidget::changeStatus()
     case SyncthingStatus::Scanning:
     case SyncthingStatus::Synchronizing:
     case SyncthingStatus::RemoteNotInSync:
-        m_connection.pauseAllDevs();
+        m_connection->pauseAllDevs();
         break;
     case SyncthingStatus::Paused:
-        m_connection.resumeAllDevs();
+        m_connection->resumeAllDevs();
         break;
     default:;
     }
@@ -646,15 +670,16 @@ void TrayWidget::updateTraffic()
     }();
 
     // update text and whether to use active/inactive icons
-    m_ui->inTrafficLabel->setText(trafficString(m_connection.totalIncomingTraffic(), m_connection.totalIncomingRate()));
-    m_ui->outTrafficLabel->setText(trafficString(m_connection.totalOutgoingTraffic(), m_connection.totalOutgoingRate()));
-    m_ui->trafficInTextLabel->setPixmap(m_connection.totalIncomingRate() > 0.0 ? trafficIcons.downloadIconActive : trafficIcons.downloadIconInactive);
-    m_ui->trafficOutTextLabel->setPixmap(m_connection.totalOutgoingRate() > 0.0 ? trafficIcons.uploadIconActive : trafficIcons.uploadIconInactive);
+    m_ui->inTrafficLabel->setText(trafficString(m_connection->totalIncomingTraffic(), m_connection->totalIncomingRate()));
+    m_ui->outTrafficLabel->setText(trafficString(m_connection->totalOutgoingTraffic(), m_connection->totalOutgoingRate()));
+    m_ui->trafficInTextLabel->setPixmap(
+        m_connection->totalIncomingRate() > 0.0 ? trafficIcons.downloadIconActive : trafficIcons.downloadIconInactive);
+    m_ui->trafficOutTextLabel->setPixmap(m_connection->totalOutgoingRate() > 0.0 ? trafficIcons.uploadIconActive : trafficIcons.uploadIconInactive);
 }
 
 void TrayWidget::updateOverallStatistics()
 {
-    const auto overallStats = m_connection.computeOverallDirStatistics();
+    const auto overallStats = m_connection->computeOverallDirStatistics();
     m_ui->globalStatisticsLabel->setText(directoryStatusString(overallStats.global));
     m_ui->localStatisticsLabel->setText(directoryStatusString(overallStats.local));
 }
@@ -682,7 +707,7 @@ void TrayWidget::toggleRunning()
     case StartStopButtonTarget::Launcher:
         if (auto *const launcher = SyncthingLauncher::mainInstance()) {
             if (launcher->isRunning()) {
-                launcher->terminate(&m_connection);
+                launcher->terminate(m_connection.get());
             } else {
                 launcher->launch(Settings::values().launcher);
             }
@@ -695,7 +720,7 @@ void TrayWidget::toggleRunning()
 Settings::Launcher::LauncherStatus TrayWidget::handleLauncherStatusChanged()
 {
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
-    const auto systemdStatus = Settings::values().systemd.status(m_connection);
+    const auto systemdStatus = Settings::values().systemd.status(*m_connection);
     const auto launcherStatus = applyLauncherSettings(false, systemdStatus.consideredForReconnect, systemdStatus.showStartStopButton);
     const auto showStartStopButton = systemdStatus.showStartStopButton || launcherStatus.showStartStopButton;
 #else
@@ -710,8 +735,8 @@ Settings::Launcher::LauncherStatus TrayWidget::applyLauncherSettings(bool reconn
 {
     // update connection
     const auto &launcherSettings = Settings::values().launcher;
-    const auto launcherStatus = skipApplyingToConnection ? launcherSettings.status(m_connection)
-                                                         : launcherSettings.apply(m_connection, m_selectedConnection, reconnectRequired);
+    const auto launcherStatus = skipApplyingToConnection ? launcherSettings.status(*m_connection)
+                                                         : launcherSettings.apply(*m_connection, m_selectedConnection, reconnectRequired);
 
     if (skipStartStopButton || !launcherStatus.showStartStopButton) {
         return launcherStatus;
@@ -753,7 +778,7 @@ Settings::Systemd::ServiceStatus TrayWidget::applySystemdSettings(bool reconnect
 {
     // update connection
     const auto &systemdSettings = Settings::values().systemd;
-    const auto serviceStatus = systemdSettings.apply(m_connection, m_selectedConnection, reconnectRequired);
+    const auto serviceStatus = systemdSettings.apply(*m_connection, m_selectedConnection, reconnectRequired);
 
     if (!serviceStatus.showStartStopButton) {
         return serviceStatus;
@@ -800,7 +825,12 @@ void TrayWidget::handleConnectionSelected(QAction *connectionAction)
         m_selectedConnection
             = (index == 0) ? &Settings::values().connection.primary : &Settings::values().connection.secondary[static_cast<size_t>(index - 1)];
         m_ui->connectionsPushButton->setText(m_selectedConnection->label);
-        m_connection.reconnect(*m_selectedConnection);
+        auto reconnectRequired = false;
+        setConnection(SyncthingConnectionRegistry::instance().acquire(*m_selectedConnection, m_connection, reconnectRequired));
+        m_connection->setSnapshotPath(m_selectedConnection->defaultSnapshotPath());
+        if (reconnectRequired || !m_connection->isConnected()) {
+            m_connection->reconnect();
+        }
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
         handleSystemdStatusChanged();
 #endif
@@ -812,6 +842,63 @@ void TrayWidget::handleConnectionSelected(QAction *connectionAction)
     }
 }
 
+/*!
+ * \brief Binds the notifier, the models and the UI to the specified \a connection.
+ * \remarks
+ * - The \a connection might be shared with other tray widgets (see SyncthingConnectionRegistry) so only signals of the
+ *   connection are connected here but the connection is not reconfigured.
+ * - Emits connectionChanged() before the previous connection is released so handlers can still disconnect from it.
+ */
+void TrayWidget::setConnection(std::shared_ptr<Data::SyncthingConnection> &&connection)
+{
+    if (m_connection == connection) {
+        return;
+    }
+    setVisibleOnConnection(false);
+    const auto previousConnection = std::exchange(m_connection, std::move(connection));
+    if (previousConnection) {
+        QObject::disconnect(previousConnection.get(), nullptr, this, nullptr);
+        // the settings dialog might refer to the previous connection which is not necessarily kept alive
+        if (s_settingsDlg) {
+            s_settingsDlg->hideConnectionStatus();
+        }
+    }
+
+    // re-create notifier and models for the new connection; the views are updated before the previous models are destroyed
+    const auto brightColors = Settings::values().appearance.brightTextColors;
+    auto notifier = std::make_unique<SyncthingNotifier>(*m_connection);
+    auto dirModel = std::make_unique<SyncthingDirectoryModel>(*m_connection);
+    auto devModel = std::make_unique<SyncthingDeviceModel>(*m_connection);
+    auto dlModel = std::make_unique<SyncthingDownloadModel>(*m_connection);
+    auto recentChangesModel = std::make_unique<SyncthingRecentChangesModel>(*m_connection);
+    Settings::values().apply(*notifier);
+    dirModel->setBrightColors(brightColors);
+    devModel->setBrightColors(brightColors);
+    dlModel->setBrightColors(brightColors);
+    recentChangesModel->setBrightColors(brightColors);
+    m_sortFilterDirModel.setSourceModel(dirModel.get());
+    m_sortFilterDevModel.setSourceModel(devModel.get());
+    m_ui->downloadsTreeView->setModel(dlModel.get());
+    m_ui->recentChangesTreeView->setModel(recentChangesModel.get());
+    m_notifier = std::move(notifier);
+    m_dirModel = std::move(dirModel);
+    m_devModel = std::move(devModel);
+    m_dlModel = std::move(dlModel);
+    m_recentChangesModel = std::move(recentChangesModel);
+
+    connect(m_connection.get(), &SyncthingConnection::statusChanged, this, &TrayWidget::handleStatusChanged);
+    connect(m_connection.get(), &SyncthingConnection::trafficChanged, this, &TrayWidget::updateTraffic);
+    connect(m_connection.get(), &SyncthingConnection::dirStatisticsChanged, this, &TrayWidget::updateOverallStatistics);
+    connect(m_connection.get(), &SyncthingConnection::newNotification, this, &TrayWidget::handleNewNotification);
+    setVisibleOnConnection(isVisible());
+    if (previousConnection) {
+        handleStatusChanged(m_connection->status());
+        updateTraffic();
+        updateOverallStatistics();
+        emit connectionChanged(previousConnection.get());
+    }
+}
+
 void TrayWidget::showDialog(QWidget *dlg, bool maximized)
 {
     if (m_menu) {
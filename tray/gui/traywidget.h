@@ -74,6 +74,13 @@ public Q_SLOTS:
     void quitTray();
     void applySettings(const QString &connectionConfig = QString());
 
+Q_SIGNALS:
+    void connectionChanged(Data::SyncthingConnection *previousConnection);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 private Q_SLOTS:
     void handleStatusChanged(Data::SyncthingStatus status);
 #ifdef SYNCTHINGTRAY_UNIFY_TRAY_MENUS
@@ -106,6 +113,9 @@ private Q_SLOTS:
     void showDialog(QWidget *dlg, bool maximized = false);
 
 private:
+    void setConnection(std::shared_ptr<Data::SyncthingConnection> &&connection);
+    void setVisibleOnConnection(bool visible);
+
     TrayMenu *m_menu;
     std::unique_ptr<Ui::TrayWidget> m_ui;
     static QWidget *s_dialogParent;
@@ -118,41 +128,42 @@ private:
 #ifdef SYNCTHINGTRAY_UNIFY_TRAY_MENUS
     QPushButton *m_internalErrorsButton;
 #endif
-    Data::SyncthingConnection m_connection;
-    Data::SyncthingNotifier m_notifier;
-    Data::SyncthingDirectoryModel m_dirModel;
+    std::shared_ptr<Data::SyncthingConnection> m_connection;
+    std::unique_ptr<Data::SyncthingNotifier> m_notifier;
+    std::unique_ptr<Data::SyncthingDirectoryModel> m_dirModel;
     Data::SyncthingSortFilterModel m_sortFilterDirModel;
-    Data::SyncthingDeviceModel m_devModel;
+    std::unique_ptr<Data::SyncthingDeviceModel> m_devModel;
     Data::SyncthingSortFilterModel m_sortFilterDevModel;
-    Data::SyncthingDownloadModel m_dlModel;
-    Data::SyncthingRecentChangesModel m_recentChangesModel;
+    std::unique_ptr<Data::SyncthingDownloadModel> m_dlModel;
+    std::unique_ptr<Data::SyncthingRecentChangesModel> m_recentChangesModel;
     QMenu *m_connectionsMenu;
     QActionGroup *m_connectionsActionGroup;
     Data::SyncthingConnectionSettings *m_selectedConnection;
     QMenu *m_notificationsMenu;
     std::vector<Data::SyncthingLogEntry> m_notifications;
     enum class StartStopButtonTarget { None, Service, Launcher } m_startStopButtonTarget;
+    bool m_visibleOnConnection;
     static std::vector<TrayWidget *> s_instances;
 };
 
 inline Data::SyncthingConnection &TrayWidget::connection()
 {
-    return m_connection;
+    return *m_connection;
 }
 
 inline const Data::SyncthingConnection &TrayWidget::connection() const
 {
-    return m_connection;
+    return *m_connection;
 }
 
 inline Data::SyncthingNotifier &TrayWidget::notifier()
 {
-    return m_notifier;
+    return *m_notifier;
 }
 
 inline const Data::SyncthingNotifier &TrayWidget::notifier() const
 {
-    return m_notifier;
+    return *m_notifier;
 }
 
 inline QMenu *TrayWidget::connectionsMenu()
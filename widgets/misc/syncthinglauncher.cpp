@@ -2,6 +2,9 @@
 
 #include "../settings/settings.h"
 
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
 #include <QtConcurrentRun>
 
 #include <algorithm>
@@ -24,6 +27,9 @@ SyncthingLauncher *SyncthingLauncher::s_mainInstance = nullptr;
  * - This is *not* strictly a singleton class. However, one instance is supposed to be the "main instance" (see SyncthingLauncher::setMainInstance()).
  * - A SyncthingLauncher instance can only launch one Syncthing instance at a time.
  * - Using Syncthing as library is still under development and must be explicitly enabled by setting the CMake variable USE_LIBSYNCTHING.
+ * - While not emitting output, only the most recent output up to maxOutputBufferSize() is buffered in memory. Older output is
+ *   discarded or written to outputSpillFilePath() (rotated once maxOutputSpillFileSize is exceeded) from where it can be read
+ *   page-wise via readSpilledOutput().
  */
 
 /*!
@@ -36,6 +42,8 @@ SyncthingLauncher::SyncthingLauncher(QObject *parent)
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     , m_libsyncthingLogLevel(LibSyncthing::LogLevel::Info)
 #endif
+    , m_outputBufferSize(0)
+    , m_maxOutputBufferSize(Settings::Launcher::defaultOutputBufferSize)
     , m_manuallyStopped(true)
     , m_emittingOutput(false)
 {
@@ -49,17 +57,105 @@ SyncthingLauncher::SyncthingLauncher(QObject *parent)
 
 /*!
  * \brief Sets whether the output/log should be emitted via outputAvailable() signal.
+ * \remarks
+ * - The flag is only accessed with m_outputMutex locked because output might arrive from another thread. The output buffered
+ *   so far is flushed before the lock is released so it is emitted before any newer output.
+ * - As outputAvailable() is emitted with m_outputMutex locked, slots must not call functions dealing with the output directly
+ *   (but may do so via a queued connection).
  */
 void SyncthingLauncher::setEmittingOutput(bool emittingOutput)
 {
-    if (m_emittingOutput == emittingOutput || !(m_emittingOutput = emittingOutput) || m_outputBuffer.isEmpty()) {
+    const QMutexLocker locker(&m_outputMutex);
+    if (m_emittingOutput == emittingOutput || !(m_emittingOutput = emittingOutput) || m_outputBuffer.empty()) {
         return;
     }
     QByteArray data;
-    m_outputBuffer.swap(data);
+    data.reserve(static_cast<int>(m_outputBufferSize));
+    for (const auto &chunk : m_outputBuffer) {
+        data += chunk;
+    }
+    m_outputBuffer.clear();
+    m_outputBufferSize = 0;
     emit outputAvailable(move(data));
 }
 
+/*!
+ * \brief Sets the max. number of bytes of output to be buffered in memory while not emitting output.
+ * \remarks If more output is already buffered, the oldest output is discarded or written to outputSpillFilePath().
+ */
+void SyncthingLauncher::setMaxOutputBufferSize(std::size_t maxOutputBufferSize)
+{
+    const QMutexLocker locker(&m_outputMutex);
+    m_maxOutputBufferSize = maxOutputBufferSize;
+    bufferOutput(QByteArray());
+}
+
+/*!
+ * \brief Sets the path of the file older output exceeding maxOutputBufferSize() is written to.
+ * \remarks
+ * - The file is truncated when spilling output to it for the first time and rotated once maxOutputSpillFileSize is exceeded
+ *   keeping one rotated file with the suffix ".1".
+ * - Pass an empty string to discard older output.
+ */
+void SyncthingLauncher::setOutputSpillFilePath(const QString &outputSpillFilePath)
+{
+    const QMutexLocker locker(&m_outputMutex);
+    if (m_outputSpillFilePath == outputSpillFilePath) {
+        return;
+    }
+    m_outputSpillFile.close();
+    m_outputSpillFilePath = outputSpillFilePath;
+}
+
+/*!
+ * \brief Reads output previously written to outputSpillFilePath().
+ *
+ * Returns at most \a maxSize bytes ending \a offsetFromEnd bytes before the end of the spilled output (including the rotated
+ * file). So to page backwards, start with an offset of zero and increase it by the size of the returned data for each
+ * subsequent call. An empty byte array is returned once the beginning of the spilled output has been reached.
+ *
+ * \remarks Unless the beginning of the spilled output has been reached, the returned data starts at a line boundary.
+ */
+QByteArray SyncthingLauncher::readSpilledOutput(qint64 offsetFromEnd, qint64 maxSize)
+{
+    const QMutexLocker locker(&m_outputMutex);
+    if (!m_outputSpillFile.isOpen() || maxSize <= 0) {
+        return QByteArray();
+    }
+    m_outputSpillFile.flush();
+
+    // determine the range to read within the concatenation of the rotated and the current file
+    QFile rotatedFile(m_outputSpillFilePath + QStringLiteral(".1"));
+    const auto rotatedSize = rotatedFile.exists() ? rotatedFile.size() : 0;
+    const auto end = rotatedSize + m_outputSpillFile.size() - offsetFromEnd;
+    if (end <= 0) {
+        return QByteArray();
+    }
+    const auto begin = max<qint64>(0, end - maxSize);
+
+    // read the range
+    QByteArray data;
+    data.reserve(static_cast<int>(end - begin));
+    if (begin < rotatedSize && rotatedFile.open(QIODevice::ReadOnly) && rotatedFile.seek(begin)) {
+        data += rotatedFile.read(min(end, rotatedSize) - begin);
+    }
+    if (end > rotatedSize) {
+        QFile currentFile(m_outputSpillFilePath);
+        const auto currentBegin = max(begin, rotatedSize);
+        if (currentFile.open(QIODevice::ReadOnly) && currentFile.seek(currentBegin - rotatedSize)) {
+            data += currentFile.read(end - currentBegin);
+        }
+    }
+
+    // skip the incomplete first line; it will be returned by the next call
+    if (begin > 0) {
+        if (const auto firstLineEnd = data.indexOf('\n'); firstLineEnd >= 0 && firstLineEnd + 1 < data.size()) {
+            data.remove(0, firstLineEnd + 1);
+        }
+    }
+    return data;
+}
+
 /*!
  * \brief Returns whether the built-in Syncthing library is available.
  */
@@ -84,6 +180,14 @@ QString SyncthingLauncher::libSyncthingVersionInfo()
 #endif
 }
 
+/*!
+ * \brief Returns the path of the file within the cache directory output is written to if spilling output is enabled.
+ */
+QString SyncthingLauncher::defaultOutputSpillFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/syncthing-output.log");
+}
+
 /*!
  * \brief Launches a Syncthing instance using the specified \a arguments.
  *
@@ -119,6 +223,7 @@ void SyncthingLauncher::launch(const QString &program, const QStringList &argume
  */
 void SyncthingLauncher::launch(const Settings::Launcher &launcherSettings)
 {
+    applyOutputSettings(launcherSettings);
     if (isRunning()) {
         return;
     }
@@ -141,6 +246,15 @@ void SyncthingLauncher::launch(const Settings::Launcher &launcherSettings)
     }
 }
 
+/*!
+ * \brief Applies the output-related settings from the specified \a launcherSettings.
+ */
+void SyncthingLauncher::applyOutputSettings(const Settings::Launcher &launcherSettings)
+{
+    setMaxOutputBufferSize(launcherSettings.outputBufferSize);
+    setOutputSpillFilePath(launcherSettings.spillOutput ? defaultOutputSpillFilePath() : QString());
+}
+
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
 /*!
  * \brief Launches a Syncthing instance using the internal library with the specified \a runtimeOptions.
@@ -248,11 +362,58 @@ void SyncthingLauncher::handleLoggingCallback(LibSyncthing::LogLevel level, cons
 void SyncthingLauncher::handleOutputAvailable(QByteArray &&data)
 {
     m_guiListeningUrlSearch(data.data(), static_cast<std::size_t>(data.size()));
-    if (isEmittingOutput()) {
+    const QMutexLocker locker(&m_outputMutex);
+    if (m_emittingOutput) {
         emit outputAvailable(data);
     } else {
-        m_outputBuffer += data;
+        bufferOutput(move(data));
+    }
+}
+
+/*!
+ * \brief Appends the specified \a data to the in-memory buffer evicting the oldest output if maxOutputBufferSize() is exceeded.
+ * \remarks Evicting output is O(1) as the buffer consists of the chunks of output as they were received. The caller must lock
+ *          m_outputMutex.
+ */
+void SyncthingLauncher::bufferOutput(QByteArray &&data)
+{
+    if (!data.isEmpty()) {
+        m_outputBufferSize += static_cast<std::size_t>(data.size());
+        m_outputBuffer.emplace_back(move(data));
+    }
+    while (m_outputBufferSize > m_maxOutputBufferSize && !m_outputBuffer.empty()) {
+        const auto &oldestData = m_outputBuffer.front();
+        m_outputBufferSize -= static_cast<std::size_t>(oldestData.size());
+        spillOutput(oldestData);
+        m_outputBuffer.pop_front();
+    }
+}
+
+/*!
+ * \brief Writes the specified \a data to outputSpillFilePath() if configured, rotating the file if it would become too big.
+ * \remarks The caller must lock m_outputMutex.
+ */
+void SyncthingLauncher::spillOutput(const QByteArray &data)
+{
+    if (m_outputSpillFilePath.isEmpty()) {
+        return;
+    }
+    const auto rotatedFilePath = QString(m_outputSpillFilePath + QStringLiteral(".1"));
+    if (!m_outputSpillFile.isOpen()) {
+        QDir().mkpath(QFileInfo(m_outputSpillFilePath).path());
+        QFile::remove(rotatedFilePath);
+        m_outputSpillFile.setFileName(m_outputSpillFilePath);
+    } else if (m_outputSpillFile.size() + data.size() > maxOutputSpillFileSize) {
+        m_outputSpillFile.close();
+        QFile::remove(rotatedFilePath);
+        QFile::rename(m_outputSpillFilePath, rotatedFilePath);
+    }
+    if (!m_outputSpillFile.isOpen() && !m_outputSpillFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        // discard older output if the file can not be opened
+        m_outputSpillFilePath.clear();
+        return;
     }
+    m_outputSpillFile.write(data);
 }
 
 void SyncthingLauncher::handleGuiListeningUrlFound(CppUtilities::BufferSearch &, std::string &&searchResult)
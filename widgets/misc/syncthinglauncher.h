@@ -12,18 +12,25 @@
 #include <c++utilities/io/buffersearch.h>
 
 #include <QByteArray>
+#include <QFile>
 #include <QFuture>
+#include <QMutex>
 #include <QUrl>
 
+#include <deque>
+
 namespace Settings {
 struct Launcher;
 }
 
+class LauncherTests;
+
 namespace Data {
 
 class SyncthingConnection;
 
 class SYNCTHINGWIDGETS_EXPORT SyncthingLauncher : public QObject {
+    friend LauncherTests;
     Q_OBJECT
     Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
     Q_PROPERTY(CppUtilities::DateTime activeSince READ activeSince)
@@ -41,6 +48,11 @@ public:
     bool isManuallyStopped() const;
     bool isEmittingOutput() const;
     void setEmittingOutput(bool emittingOutput);
+    std::size_t maxOutputBufferSize() const;
+    void setMaxOutputBufferSize(std::size_t maxOutputBufferSize);
+    QString outputSpillFilePath() const;
+    void setOutputSpillFilePath(const QString &outputSpillFilePath);
+    QByteArray readSpilledOutput(qint64 offsetFromEnd, qint64 maxSize);
     QString errorString() const;
     QUrl guiUrl() const;
     SyncthingProcess *process();
@@ -53,6 +65,8 @@ public:
     static SyncthingLauncher *mainInstance();
     static void setMainInstance(SyncthingLauncher *mainInstance);
     static QString libSyncthingVersionInfo();
+    static QString defaultOutputSpillFilePath();
+    static constexpr qint64 maxOutputSpillFileSize = 8 * 1024 * 1024;
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     void launch(const LibSyncthing::RuntimeOptions &runtimeOptions);
 #endif
@@ -68,6 +82,7 @@ Q_SIGNALS:
 public Q_SLOTS:
     void launch(const QString &program, const QStringList &arguments);
     void launch(const Settings::Launcher &launcherSettings);
+    void applyOutputSettings(const Settings::Launcher &launcherSettings);
     void terminate(SyncthingConnection *relevantConnection = nullptr);
     void kill();
     void tearDownLibSyncthing();
@@ -89,13 +104,20 @@ private:
     void handleLoggingCallback(LibSyncthing::LogLevel, const char *message, std::size_t messageSize);
 #endif
     void handleOutputAvailable(QByteArray &&data);
+    void bufferOutput(QByteArray &&data);
+    void spillOutput(const QByteArray &data);
     void handleGuiListeningUrlFound(CppUtilities::BufferSearch &bufferSearch, std::string &&searchResult);
 
     SyncthingProcess m_process;
     QUrl m_guiListeningUrl;
     QFuture<void> m_startFuture;
     QFuture<void> m_stopFuture;
-    QByteArray m_outputBuffer;
+    mutable QMutex m_outputMutex;
+    std::deque<QByteArray> m_outputBuffer;
+    std::size_t m_outputBufferSize;
+    std::size_t m_maxOutputBufferSize;
+    QString m_outputSpillFilePath;
+    QFile m_outputSpillFile;
     CppUtilities::BufferSearch m_guiListeningUrlSearch;
     CppUtilities::DateTime m_futureStarted;
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
@@ -142,9 +164,24 @@ inline bool SyncthingLauncher::isManuallyStopped() const
 /// \brief Returns whether the output/log should be emitted via outputAvailable() signal.
 inline bool SyncthingLauncher::isEmittingOutput() const
 {
+    const QMutexLocker locker(&m_outputMutex);
     return m_emittingOutput;
 }
 
+/// \brief Returns the max. number of bytes of output to be buffered in memory while not emitting output.
+inline std::size_t SyncthingLauncher::maxOutputBufferSize() const
+{
+    return m_maxOutputBufferSize;
+}
+
+/// \brief Returns the path of the file older output exceeding maxOutputBufferSize() is written to.
+/// \remarks An empty string means that older output is discarded.
+inline QString SyncthingLauncher::outputSpillFilePath() const
+{
+    const QMutexLocker locker(&m_outputMutex);
+    return m_outputSpillFilePath;
+}
+
 /// \brief Returns the last error message.
 inline QString SyncthingLauncher::errorString() const
 {
@@ -289,8 +289,17 @@ void restore()
                 = settings.value(QStringLiteral("devStatsPollInterval"), connectionSettings->devStatsPollInterval).toInt();
             connectionSettings->errorsPollInterval
                 = settings.value(QStringLiteral("errorsPollInterval"), connectionSettings->errorsPollInterval).toInt();
+            connectionSettings->maxPollBackoffFactor
+                = settings.value(QStringLiteral("maxPollBackoffFactor"), connectionSettings->maxPollBackoffFactor).toInt();
             connectionSettings->reconnectInterval
                 = settings.value(QStringLiteral("reconnectInterval"), connectionSettings->reconnectInterval).toInt();
+            connectionSettings->maxConcurrentRequests
+                = settings.value(QStringLiteral("maxConcurrentRequests"), connectionSettings->maxConcurrentRequests).toInt();
+            connectionSettings->recentChangesCapacity = static_cast<std::size_t>(
+                settings.value(QStringLiteral("recentChangesCapacity"), static_cast<qulonglong>(connectionSettings->recentChangesCapacity)).toULongLong());
+            connectionSettings->recentChangesMemoryBudget = static_cast<std::size_t>(settings
+                    .value(QStringLiteral("recentChangesMemoryBudget"), static_cast<qulonglong>(connectionSettings->recentChangesMemoryBudget))
+                    .toULongLong());
             connectionSettings->autoConnect = settings.value(QStringLiteral("autoConnect"), connectionSettings->autoConnect).toBool();
             const auto statusComputionFlags = settings.value(QStringLiteral("statusComputionFlags"),
                 QVariant::fromValue(static_cast<UnderlyingFlagType>(connectionSettings->statusComputionFlags)));
@@ -356,6 +365,9 @@ void restore()
     launcher.syncthingArgs = settings.value(QStringLiteral("syncthingArgs"), launcher.syncthingArgs).toString();
     launcher.considerForReconnect = settings.value(QStringLiteral("considerLauncherForReconnect"), launcher.considerForReconnect).toBool();
     launcher.showButton = settings.value(QStringLiteral("showLauncherButton"), launcher.showButton).toBool();
+    launcher.outputBufferSize = static_cast<std::size_t>(
+        settings.value(QStringLiteral("launcherOutputBufferSize"), static_cast<qulonglong>(launcher.outputBufferSize)).toULongLong());
+    launcher.spillOutput = settings.value(QStringLiteral("spillLauncherOutput"), launcher.spillOutput).toBool();
     settings.beginGroup(QStringLiteral("tools"));
     const auto childGroups = settings.childGroups();
     for (const QString &tool : childGroups) {
@@ -413,7 +425,11 @@ void save()
         settings.setValue(QStringLiteral("trafficPollInterval"), connectionSettings->trafficPollInterval);
         settings.setValue(QStringLiteral("devStatsPollInterval"), connectionSettings->devStatsPollInterval);
         settings.setValue(QStringLiteral("errorsPollInterval"), connectionSettings->errorsPollInterval);
+        settings.setValue(QStringLiteral("maxPollBackoffFactor"), connectionSettings->maxPollBackoffFactor);
         settings.setValue(QStringLiteral("reconnectInterval"), connectionSettings->reconnectInterval);
+        settings.setValue(QStringLiteral("maxConcurrentRequests"), connectionSettings->maxConcurrentRequests);
+        settings.setValue(QStringLiteral("recentChangesCapacity"), static_cast<qulonglong>(connectionSettings->recentChangesCapacity));
+        settings.setValue(QStringLiteral("recentChangesMemoryBudget"), static_cast<qulonglong>(connectionSettings->recentChangesMemoryBudget));
         settings.setValue(QStringLiteral("autoConnect"), connectionSettings->autoConnect);
         settings.setValue(QStringLiteral("statusComputionFlags"),
             QVariant::fromValue(static_cast<std::underlying_type_t<Data::SyncthingStatusComputionFlags>>(connectionSettings->statusComputionFlags)));
@@ -464,6 +480,8 @@ void save()
     settings.setValue(QStringLiteral("syncthingArgs"), launcher.syncthingArgs);
     settings.setValue(QStringLiteral("considerLauncherForReconnect"), launcher.considerForReconnect);
     settings.setValue(QStringLiteral("showLauncherButton"), launcher.showButton);
+    settings.setValue(QStringLiteral("launcherOutputBufferSize"), static_cast<qulonglong>(launcher.outputBufferSize));
+    settings.setValue(QStringLiteral("spillLauncherOutput"), launcher.spillOutput);
     settings.beginGroup(QStringLiteral("tools"));
     for (auto i = launcher.tools.cbegin(), end = launcher.tools.cend(); i != end; ++i) {
         const ToolParameter &toolParams = i.value();
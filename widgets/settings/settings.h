@@ -89,6 +89,9 @@ struct SYNCTHINGWIDGETS_EXPORT Launcher {
     QHash<QString, ToolParameter> tools;
     bool considerForReconnect = false;
     bool showButton = false;
+    static constexpr std::size_t defaultOutputBufferSize = 1024 * 1024;
+    std::size_t outputBufferSize = defaultOutputBufferSize;
+    bool spillOutput = false;
 
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     struct SYNCTHINGWIDGETS_EXPORT LibSyncthing {
@@ -55,6 +55,7 @@
 #include <QApplication>
 #include <QFontDatabase>
 #include <QMenu>
+#include <QScrollBar>
 #include <QStringBuilder>
 #include <QStyle>
 #include <QTextBlock>
@@ -884,6 +885,7 @@ LauncherOptionPage::LauncherOptionPage(QWidget *parentWidget)
     , LauncherOptionPageBase(parentWidget)
     , m_process(nullptr)
     , m_launcher(SyncthingLauncher::mainInstance())
+    , m_spilledOutputLoaded(0)
     , m_kill(false)
 {
 }
@@ -894,6 +896,7 @@ LauncherOptionPage::LauncherOptionPage(const QString &tool, const QString &toolN
     , m_process(&Launcher::toolProcess(tool))
     , m_launcher(nullptr)
     , m_restoreArgsAction(nullptr)
+    , m_spilledOutputLoaded(0)
     , m_kill(false)
     , m_tool(tool)
     , m_toolName(toolName)
@@ -919,9 +922,10 @@ QWidget *LauncherOptionPage::setupWidget()
         ui()->syncthingPathLabel->setText(tr("%1 executable").arg(toolNameStartingSentence));
         ui()->logLabel->setText(tr("%1 log (interleaved stdout/stderr)").arg(toolNameStartingSentence));
 
-        // hide "consider for reconnect" and "show start/stop button on tray" checkboxes for tools
+        // hide "consider for reconnect" and "show start/stop button on tray" checkboxes as well as output settings for tools
         ui()->considerForReconnectCheckBox->setVisible(false);
         ui()->showButtonCheckBox->setVisible(false);
+        ui()->outputSettingsWidget->setVisible(false);
     }
 
     // hide libsyncthing-controls by default (as the checkbox is unchecked by default)
@@ -976,6 +980,9 @@ QWidget *LauncherOptionPage::setupWidget()
             &LauncherOptionPage::updateLibSyncthingLogLevel);
 #endif
         m_launcher->setEmittingOutput(true);
+        // load output written to disk before on demand when scrolling to the top
+        connect(ui()->logTextEdit->verticalScrollBar(), &QScrollBar::valueChanged, this, &LauncherOptionPage::handleLogScrolled);
+        QMetaObject::invokeMethod(this, "loadSpilledOutput", Qt::QueuedConnection);
     }
     connect(ui()->launchNowPushButton, &QPushButton::clicked, this, &LauncherOptionPage::launch);
     connect(ui()->stopPushButton, &QPushButton::clicked, this, &LauncherOptionPage::stop);
@@ -998,6 +1005,11 @@ bool LauncherOptionPage::apply()
         settings.syncthingArgs = ui()->argumentsLineEdit->text();
         settings.considerForReconnect = ui()->considerForReconnectCheckBox->isChecked();
         settings.showButton = ui()->showButtonCheckBox->isChecked();
+        settings.outputBufferSize = static_cast<std::size_t>(ui()->outputBufferSizeSpinBox->value()) * 1024;
+        settings.spillOutput = ui()->spillOutputCheckBox->isChecked();
+        if (m_launcher) {
+            m_launcher->applyOutputSettings(settings);
+        }
     } else {
         ToolParameter &params = settings.tools[m_tool];
         params.autostart = ui()->enabledCheckBox->isChecked();
@@ -1023,6 +1035,8 @@ void LauncherOptionPage::reset()
         ui()->argumentsLineEdit->setText(settings.syncthingArgs);
         ui()->considerForReconnectCheckBox->setChecked(settings.considerForReconnect);
         ui()->showButtonCheckBox->setChecked(settings.showButton);
+        ui()->outputBufferSizeSpinBox->setValue(static_cast<int>(settings.outputBufferSize / 1024));
+        ui()->spillOutputCheckBox->setChecked(settings.spillOutput);
     } else {
         const ToolParameter params = settings.tools.value(m_tool);
         ui()->useBuiltInVersionCheckBox->setChecked(false);
@@ -1049,6 +1063,33 @@ void LauncherOptionPage::handleSyncthingReadyRead()
     handleSyncthingOutputAvailable(m_process->readAll());
 }
 
+void LauncherOptionPage::handleLogScrolled(int value)
+{
+    if (value == ui()->logTextEdit->verticalScrollBar()->minimum()) {
+        loadSpilledOutput();
+    }
+}
+
+void LauncherOptionPage::loadSpilledOutput()
+{
+    if (!hasBeenShown()) {
+        return;
+    }
+    const auto output = m_launcher->readSpilledOutput(m_spilledOutputLoaded, 64 * 1024);
+    if (output.isEmpty()) {
+        return;
+    }
+    m_spilledOutputLoaded += output.size();
+
+    // prepend the output preserving the scroll position relative to the end
+    auto *const scrollBar = ui()->logTextEdit->verticalScrollBar();
+    const auto distanceFromEnd = scrollBar->maximum() - scrollBar->value();
+    QTextCursor cursor(ui()->logTextEdit->document());
+    cursor.movePosition(QTextCursor::Start);
+    cursor.insertText(QString::fromUtf8(output));
+    scrollBar->setValue(scrollBar->maximum() - distanceFromEnd);
+}
+
 void LauncherOptionPage::handleSyncthingOutputAvailable(const QByteArray &output)
 {
     if (!hasBeenShown()) {
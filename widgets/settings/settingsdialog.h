@@ -118,6 +118,8 @@ private Q_SLOTS:
     void handleSyncthingLaunched(bool running);
     void handleSyncthingReadyRead();
     void handleSyncthingOutputAvailable(const QByteArray &output);
+    void handleLogScrolled(int value);
+    void loadSpilledOutput();
     void handleSyncthingExited(int exitCode, QProcess::ExitStatus exitStatus);
     void handleSyncthingError(QProcess::ProcessError error);
     bool isRunning() const;
@@ -135,6 +137,7 @@ private:
     Data::SyncthingLauncher *const m_launcher;
     QAction *m_restoreArgsAction;
     QAction *m_syncthingDownloadAction;
+    qint64 m_spilledOutputLoaded;
     bool m_kill;
     QString m_tool, m_toolName, m_windowTitle;
 };
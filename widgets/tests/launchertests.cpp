@@ -0,0 +1,133 @@
+#include "../misc/syncthinglauncher.h"
+#include "../settings/settings.h"
+
+#include <c++utilities/tests/testutils.h>
+
+#include "../../testhelper/helper.h"
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QTemporaryDir>
+
+using namespace std;
+using namespace Data;
+using namespace CppUtilities;
+
+using namespace CPPUNIT_NS;
+
+/*!
+ * \brief The LauncherTests class tests the SyncthingLauncher class.
+ */
+class LauncherTests : public TestFixture {
+    CPPUNIT_TEST_SUITE(LauncherTests);
+    CPPUNIT_TEST(testBufferingOutput);
+    CPPUNIT_TEST(testSpillingOutput);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    LauncherTests();
+
+    void testBufferingOutput();
+    void testSpillingOutput();
+
+    void setUp() override;
+    void tearDown() override;
+
+private:
+    static std::string emittedOutput(SyncthingLauncher &launcher);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LauncherTests);
+
+LauncherTests::LauncherTests()
+{
+}
+
+//
+// test setup
+//
+
+void LauncherTests::setUp()
+{
+}
+
+void LauncherTests::tearDown()
+{
+}
+
+/*!
+ * \brief Returns the output the specified \a launcher has buffered so far by letting it emit the output.
+ */
+std::string LauncherTests::emittedOutput(SyncthingLauncher &launcher)
+{
+    QByteArray output;
+    const auto connection = QObject::connect(&launcher, &SyncthingLauncher::outputAvailable, [&output](const QByteArray &data) { output += data; });
+    launcher.setEmittingOutput(true);
+    launcher.setEmittingOutput(false);
+    QObject::disconnect(connection);
+    return output.toStdString();
+}
+
+//
+// actual test
+//
+
+/*!
+ * \brief Tests whether only the most recent output is buffered in memory and older output is discarded if not spilling output.
+ */
+void LauncherTests::testBufferingOutput()
+{
+    SyncthingLauncher launcher;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("default buffer size", Settings::Launcher::defaultOutputBufferSize, launcher.maxOutputBufferSize());
+
+    launcher.setMaxOutputBufferSize(16);
+    for (const auto *const line : { "line 1\n", "line 2\n", "line 3\n", "line 4\n", "line 5\n" }) {
+        launcher.handleOutputAvailable(QByteArray(line));
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("only output within budget kept", std::string("line 4\nline 5\n"), emittedOutput(launcher));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("buffer cleared after emitting", std::string(), emittedOutput(launcher));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("older output discarded", std::string(), launcher.readSpilledOutput(0, 1024).toStdString());
+}
+
+/*!
+ * \brief Tests whether output exceeding the in-memory budget is written to disk and can be read back page-wise.
+ */
+void LauncherTests::testSpillingOutput()
+{
+    const QTemporaryDir tempDir;
+    CPPUNIT_ASSERT_MESSAGE("temporary directory created", tempDir.isValid());
+
+    SyncthingLauncher launcher;
+    auto settings = Settings::Launcher();
+    settings.outputBufferSize = 16;
+    settings.spillOutput = true;
+    launcher.applyOutputSettings(settings);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("buffer size applied", static_cast<std::size_t>(16), launcher.maxOutputBufferSize());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("spilling enabled", SyncthingLauncher::defaultOutputSpillFilePath(), launcher.outputSpillFilePath());
+    launcher.setOutputSpillFilePath(tempDir.filePath(QStringLiteral("output.log")));
+
+    for (const auto *const line : { "line 1\n", "line 2\n", "line 3\n", "line 4\n", "line 5\n" }) {
+        launcher.handleOutputAvailable(QByteArray(line));
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+        "all spilled output read at once", std::string("line 1\nline 2\nline 3\n"), launcher.readSpilledOutput(0, 1024).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("first page starts at line boundary", std::string("line 3\n"), launcher.readSpilledOutput(0, 10).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("second page", std::string("line 2\n"), launcher.readSpilledOutput(7, 10).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("last page", std::string("line 1\n"), launcher.readSpilledOutput(14, 10).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("beginning reached", std::string(), launcher.readSpilledOutput(21, 10).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("most recent output kept in memory", std::string("line 4\nline 5\n"), emittedOutput(launcher));
+
+    // lowering the budget spills buffered output as well
+    launcher.handleOutputAvailable(QByteArray("line 6\n"));
+    launcher.setMaxOutputBufferSize(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+        "buffered output spilled when lowering budget", std::string("line 6\n"), launcher.readSpilledOutput(0, 7).toStdString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("nothing kept in memory", std::string(), emittedOutput(launcher));
+
+    // disabling spilling discards older output again
+    settings.spillOutput = false;
+    launcher.applyOutputSettings(settings);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("spilling disabled", QString(), launcher.outputSpillFilePath());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("spilled output no longer available", std::string(), launcher.readSpilledOutput(0, 1024).toStdString());
+}